@@ -0,0 +1,6 @@
+BENCH_ARGS =
+
+bench: all
+	$(PHP_EXECUTABLE) -n -d extension_dir=$(phplibdir) -d extension=crc_fast -d memory_limit=-1 $(srcdir)/benchmarks/run.php $(BENCH_ARGS)
+
+.PHONY: bench
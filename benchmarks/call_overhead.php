@@ -0,0 +1,129 @@
+<?php
+
+/**
+ * Measures the per-call cost of CrcFast\crc32() and CrcFast\hash() on small inputs, where the call itself dominates.
+ *
+ * On PHP 8.4+, fully qualified calls with 1 (crc32) or 2-3 (hash) arguments use the frameless handlers, which skip
+ * the call frame and argument parsing. Dynamic calls through a string never do, so comparing the two in the same
+ * build shows the saving. On older PHP versions, both columns should be about the same.
+ *
+ * Usage: php -d extension=modules/crc_fast.so benchmarks/call_overhead.php [iterations]
+ *
+ * @copyright 2025 Don MacAskill
+ * @license MIT or Apache 2.0
+ */
+
+$iterations = (int)($argv[1] ?? 2000000);
+
+function bench_crc32_direct(string $data, int $iterations): float
+{
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        CrcFast\crc32($data);
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+function bench_crc32_dynamic(string $data, int $iterations): float
+{
+    $crc32 = 'CrcFast\crc32';
+
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        $crc32($data);
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+function bench_hash_direct(string $data, int $iterations): float
+{
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        CrcFast\hash(CrcFast\CRC_64_NVME, $data);
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+function bench_hash_dynamic(string $data, int $iterations): float
+{
+    $hash = 'CrcFast\hash';
+
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        $hash(CrcFast\CRC_64_NVME, $data);
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+function bench_hash_binary_direct(string $data, int $iterations): float
+{
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        CrcFast\hash(CrcFast\CRC_64_NVME, $data, true);
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+function bench_hash_binary_dynamic(string $data, int $iterations): float
+{
+    $hash = 'CrcFast\hash';
+
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+        $hash(CrcFast\CRC_64_NVME, $data, true);
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+// the baseline loop, to subtract from both
+function bench_empty(string $data, int $iterations): float
+{
+    $start = hrtime(true);
+    for ($i = 0; $i < $iterations; $i++) {
+    }
+
+    return (hrtime(true) - $start) / $iterations;
+}
+
+$cases = [
+    'crc32($data)'             => ['bench_crc32_direct', 'bench_crc32_dynamic'],
+    'hash($algo, $data)'       => ['bench_hash_direct', 'bench_hash_dynamic'],
+    'hash($algo, $data, true)' => ['bench_hash_binary_direct', 'bench_hash_binary_dynamic'],
+];
+
+printf("PHP %s, frameless handlers %s\n\n", PHP_VERSION, PHP_VERSION_ID >= 80400 ? 'available' : 'not available');
+printf("%-26s %6s %14s %14s %9s\n", 'call', 'size', 'direct ns', 'dynamic ns', 'saving');
+
+foreach ([0, 8, 16, 32, 63] as $size) {
+    $data = random_bytes($size);
+
+    // best of 5, to keep noise down
+    $loop = PHP_INT_MAX;
+    for ($run = 0; $run < 5; $run++) {
+        $loop = min($loop, bench_empty($data, $iterations));
+    }
+
+    foreach ($cases as $name => [$direct, $dynamic]) {
+        $directNs = PHP_INT_MAX;
+        $dynamicNs = PHP_INT_MAX;
+        for ($run = 0; $run < 5; $run++) {
+            $directNs = min($directNs, $direct($data, $iterations) - $loop);
+            $dynamicNs = min($dynamicNs, $dynamic($data, $iterations) - $loop);
+        }
+
+        printf(
+            "%-26s %6d %14.1f %14.1f %8.1f%%\n",
+            $name,
+            $size,
+            $directNs,
+            $dynamicNs,
+            $dynamicNs > 0 ? ($dynamicNs - $directNs) / $dynamicNs * 100 : 0
+        );
+    }
+}
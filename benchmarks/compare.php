@@ -0,0 +1,124 @@
+<?php
+
+/**
+ * Compares two JSON result files written by benchmarks/run.php, e.g. before and after an extension or library upgrade.
+ *
+ * Exits non-zero if any case present in both runs got slower by more than the threshold.
+ *
+ * Usage: php benchmarks/compare.php [--threshold=PERCENT] [--all] base.json new.json
+ *
+ * Options:
+ *   --threshold=PERCENT  Change in ns/op to treat as a regression or improvement (default 10)
+ *   --all                Show every case, not only the ones which changed by more than the threshold
+ *
+ * @copyright 2025 Don MacAskill
+ * @license MIT or Apache 2.0
+ */
+
+function load_results(string $path): array
+{
+    $json = @file_get_contents($path);
+    if ($json === false) {
+        fwrite(STDERR, "Unable to read $path\n");
+        exit(2);
+    }
+
+    $decoded = json_decode($json, true);
+    if (!is_array($decoded) || !is_array($decoded['results'] ?? null)) {
+        fwrite(STDERR, "$path is not a benchmarks/run.php JSON file\n");
+        exit(2);
+    }
+
+    $results = [];
+    foreach ($decoded['results'] as $result) {
+        $results["{$result['group']}\0{$result['name']}\0{$result['size']}"] = $result;
+    }
+
+    return [$decoded['meta'] ?? [], $results];
+}
+
+$options = getopt('', ['threshold:', 'all', 'help'], $index);
+$files = array_slice($argv, $index);
+
+if (isset($options['help']) || count($files) !== 2) {
+    echo "Usage: php benchmarks/compare.php [--threshold=PERCENT] [--all] base.json new.json\n";
+    exit(isset($options['help']) ? 0 : 2);
+}
+
+$threshold = (float)($options['threshold'] ?? 10);
+$all = isset($options['all']);
+
+[$baseMeta, $base] = load_results($files[0]);
+[$newMeta, $new] = load_results($files[1]);
+
+printf(
+    "base: crc_fast %s, PHP %s, %s %s\n",
+    $baseMeta['crc_fast'] ?? '?',
+    $baseMeta['php'] ?? '?',
+    $baseMeta['machine'] ?? '?',
+    $baseMeta['date'] ?? '?'
+);
+printf(
+    "new:  crc_fast %s, PHP %s, %s %s\n\n",
+    $newMeta['crc_fast'] ?? '?',
+    $newMeta['php'] ?? '?',
+    $newMeta['machine'] ?? '?',
+    $newMeta['date'] ?? '?'
+);
+
+printf("%-10s %-44s %12s %14s %14s %9s\n", 'group', 'case', 'size', 'base ns/op', 'new ns/op', 'change');
+
+$regressions = 0;
+$improvements = 0;
+$unchanged = 0;
+
+foreach ($new as $key => $result) {
+    if (!isset($base[$key])) {
+        continue;
+    }
+
+    $before = (float)$base[$key]['ns_per_op'];
+    $after = (float)$result['ns_per_op'];
+    $change = $before > 0 ? ($after - $before) / $before * 100 : 0.0;
+
+    if ($change > $threshold) {
+        $regressions++;
+        $marker = '  slower';
+    } elseif ($change < -$threshold) {
+        $improvements++;
+        $marker = '  faster';
+    } else {
+        $unchanged++;
+        $marker = '';
+
+        if (!$all) {
+            continue;
+        }
+    }
+
+    printf(
+        "%-10s %-44s %12s %14.1f %14.1f %+8.1f%%%s\n",
+        $result['group'],
+        $result['name'],
+        $result['size'] ?? '-',
+        $before,
+        $after,
+        $change,
+        $marker
+    );
+}
+
+$missing = count(array_diff_key($base, $new));
+$added = count(array_diff_key($new, $base));
+
+printf(
+    "\n%d slower, %d faster, %d within %.1f%%%s%s\n",
+    $regressions,
+    $improvements,
+    $unchanged,
+    $threshold,
+    $missing > 0 ? ", $missing only in base" : '',
+    $added > 0 ? ", $added only in new" : ''
+);
+
+exit($regressions > 0 ? 1 : 0);
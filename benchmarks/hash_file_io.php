@@ -0,0 +1,82 @@
+<?php
+
+/**
+ * Compares CrcFast\hash_file()'s I/O modes on a cold and a warm page cache.
+ *
+ * The cold runs evict the file first by hashing it with CrcFast\IO_BUFFERED, which drops each chunk from the page
+ * cache behind it. Run as root with --drop-caches to use /proc/sys/vm/drop_caches instead.
+ *
+ * Usage: php -d extension=modules/crc_fast.so benchmarks/hash_file_io.php [size MiB] [iterations] [--drop-caches]
+ *
+ * @copyright 2025 Don MacAskill
+ * @license MIT or Apache 2.0
+ */
+
+$args = array_values(array_filter(array_slice($argv, 1), fn ($arg) => $arg !== '--drop-caches'));
+$dropCaches = in_array('--drop-caches', $argv, true);
+$size = (int)($args[0] ?? 1024);
+$iterations = (int)($args[1] ?? 3);
+
+// Not tmpfs, which is always "cached" and doesn't support O_DIRECT
+$path = tempnam(getenv('CRC_FAST_BENCH_DIR') ?: '/var/tmp', 'crc_fast_bench_');
+register_shutdown_function(fn () => @unlink($path));
+
+$file = fopen($path, 'wb');
+$block = random_bytes(1024 * 1024);
+for ($i = 0; $i < $size; $i++) {
+    fwrite($file, $block);
+}
+fflush($file);
+fsync($file);
+fclose($file);
+
+$evict = function () use ($path, $dropCaches) {
+    if ($dropCaches) {
+        file_put_contents('/proc/sys/vm/drop_caches', '3');
+    } else {
+        CrcFast\hash_file(CrcFast\CRC_64_NVME, $path, io_mode: CrcFast\IO_BUFFERED);
+    }
+};
+
+$modes = [
+    'default' => CrcFast\IO_DEFAULT,
+    'buffered' => CrcFast\IO_BUFFERED,
+    'mmap' => CrcFast\IO_MMAP,
+    'direct' => CrcFast\IO_DIRECT,
+    'io_uring' => CrcFast\IO_URING,
+];
+
+$expected = CrcFast\hash_file(CrcFast\CRC_64_NVME, $path);
+
+printf("%d MiB file, best of %d\n\n", $size, $iterations);
+printf("%-10s %-6s %12s %12s\n", 'mode', 'cache', 'ms', 'MiB/s');
+
+foreach ($modes as $name => $mode) {
+    foreach (['cold', 'warm'] as $cache) {
+        $best = PHP_INT_MAX;
+
+        for ($iteration = 0; $iteration < $iterations; $iteration++) {
+            if ($cache === 'cold') {
+                $evict();
+            } else {
+                CrcFast\hash_file(CrcFast\CRC_64_NVME, $path); // pull it back into the page cache
+            }
+
+            try {
+                $start = hrtime(true);
+                $result = CrcFast\hash_file(CrcFast\CRC_64_NVME, $path, io_mode: $mode);
+                $best = min($best, hrtime(true) - $start);
+            } catch (Exception $e) {
+                printf("%-10s %-6s %s\n", $name, $cache, $e->getMessage());
+                continue 3;
+            }
+
+            if ($result !== $expected) {
+                fwrite(STDERR, "Results differ for $name\n");
+                exit(1);
+            }
+        }
+
+        printf("%-10s %-6s %12.1f %12.1f\n", $name, $cache, $best / 1e6, $size / ($best / 1e9));
+    }
+}
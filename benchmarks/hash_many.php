@@ -0,0 +1,55 @@
+<?php
+
+/**
+ * Compares the per-item cost of CrcFast\hash_many() against calling CrcFast\hash() in a loop.
+ *
+ * Usage: php -d extension=modules/crc_fast.so benchmarks/hash_many.php [items] [iterations]
+ *
+ * @copyright 2025 Don MacAskill
+ * @license MIT or Apache 2.0
+ */
+
+$items = (int)($argv[1] ?? 100000);
+$iterations = (int)($argv[2] ?? 10);
+
+printf("%-8s %-14s %14s %14s %9s\n", 'size', 'algorithm', 'hash() ns/item', 'many ns/item', 'speedup');
+
+foreach ([0, 8, 16, 32, 64, 256, 1024] as $size) {
+    $data = [];
+    for ($i = 0; $i < $items; $i++) {
+        $data[] = random_bytes($size);
+    }
+
+    foreach (['CRC-32/ISCSI' => CrcFast\CRC_32_ISCSI, 'CRC-64/NVME' => CrcFast\CRC_64_NVME] as $name => $algorithm) {
+        $loop = PHP_INT_MAX;
+        $many = PHP_INT_MAX;
+
+        // best of N, to keep noise down
+        for ($iteration = 0; $iteration < $iterations; $iteration++) {
+            $start = hrtime(true);
+            $results = [];
+            foreach ($data as $key => $item) {
+                $results[$key] = CrcFast\hash($algorithm, $item);
+            }
+            $loop = min($loop, hrtime(true) - $start);
+
+            $start = hrtime(true);
+            $batch = CrcFast\hash_many($algorithm, $data);
+            $many = min($many, hrtime(true) - $start);
+
+            if ($batch !== $results) {
+                fwrite(STDERR, "Results differ for $name at $size bytes\n");
+                exit(1);
+            }
+        }
+
+        printf(
+            "%-8d %-14s %14.1f %14.1f %8.2fx\n",
+            $size,
+            $name,
+            $loop / $items,
+            $many / $items,
+            $loop / $many
+        );
+    }
+}
@@ -0,0 +1,306 @@
+<?php
+
+/**
+ * Benchmark suite covering per-call overhead, throughput, and file hashing, with PHP's own hash('crc32b'),
+ * hash('crc32c'), and crc32() as baselines.
+ *
+ * Every case is a closure, timed in batches which are sized to take roughly --time seconds each, and the median of
+ * --samples batches is reported. The closure call is part of every case (including the baselines), so the small sizes
+ * measure per-call overhead rather than raw throughput.
+ *
+ * Usage: php -d extension=modules/crc_fast.so benchmarks/run.php [options]
+ *        make bench BENCH_ARGS="[options]"
+ *
+ * Options:
+ *   --json=FILE       Also write the results to FILE as JSON, for use with benchmarks/compare.php
+ *   --max-size=SIZE   Largest payload to benchmark, e.g. 64K, 16M, or 1G (default 1G)
+ *   --time=SECONDS    Target duration of each sample (default 0.1)
+ *   --samples=N       Samples per case, the median is reported (default 5)
+ *   --filter=REGEX    Only run cases whose "group/name" matches REGEX
+ *
+ * @copyright 2025 Don MacAskill
+ * @license MIT or Apache 2.0
+ */
+
+ini_set('memory_limit', '-1');
+
+const KIB = 1024;
+const MIB = 1024 * KIB;
+const GIB = 1024 * MIB;
+
+const SIZES = [0, 1, 16, 64, 256, KIB, 4 * KIB, 64 * KIB, MIB, 16 * MIB, 256 * MIB, GIB];
+
+const CHUNK_SIZES = [64, 512, 4 * KIB, 64 * KIB, MIB];
+
+function parse_size(string $size): int
+{
+    if (!preg_match('/^(\d+)\s*([KMG]?)i?B?$/i', trim($size), $matches)) {
+        fwrite(STDERR, "Invalid size \"$size\", expected e.g. 4096, 64K, 16M, or 1G\n");
+        exit(1);
+    }
+
+    return (int)$matches[1] * match (strtoupper($matches[2])) {
+        'K' => KIB,
+        'M' => MIB,
+        'G' => GIB,
+        default => 1,
+    };
+}
+
+function format_size(int $size): string
+{
+    foreach (['GiB' => GIB, 'MiB' => MIB, 'KiB' => KIB] as $unit => $bytes) {
+        if ($size >= $bytes && $size % $bytes === 0) {
+            return ($size / $bytes) . ' ' . $unit;
+        }
+    }
+
+    return $size . ' B';
+}
+
+function format_rate(?float $bytesPerSecond): string
+{
+    if ($bytesPerSecond === null) {
+        return '-';
+    }
+
+    foreach (['GiB/s' => GIB, 'MiB/s' => MIB, 'KiB/s' => KIB] as $unit => $bytes) {
+        if ($bytesPerSecond >= $bytes) {
+            return sprintf('%.2f %s', $bytesPerSecond / $bytes, $unit);
+        }
+    }
+
+    return sprintf('%.0f B/s', $bytesPerSecond);
+}
+
+/**
+ * Random-looking payload of the given size, without paying for random_bytes() on the very large ones.
+ */
+function payload(int $size): string
+{
+    static $block = null;
+    $block ??= random_bytes(MIB);
+
+    if ($size <= MIB) {
+        return substr($block, 0, $size);
+    }
+
+    return str_repeat($block, intdiv($size, MIB)) . substr($block, 0, $size % MIB);
+}
+
+/**
+ * Returns the median time of one call to $fn, in nanoseconds.
+ */
+function measure(callable $fn, float $time, int $samples): float
+{
+    $target = $time * 1e9;
+
+    // warm up, and find out roughly how many calls fit in a sample
+    $calls = 1;
+    while (true) {
+        $start = hrtime(true);
+        for ($i = 0; $i < $calls; $i++) {
+            $fn();
+        }
+        $elapsed = hrtime(true) - $start;
+
+        if ($elapsed >= $target / 10 || $calls >= 1 << 30) {
+            break;
+        }
+
+        $calls *= 2;
+    }
+    $calls = max(1, (int)($calls * $target / max($elapsed, 1)));
+
+    $results = [];
+    for ($sample = 0; $sample < $samples; $sample++) {
+        $start = hrtime(true);
+        for ($i = 0; $i < $calls; $i++) {
+            $fn();
+        }
+        $results[] = (hrtime(true) - $start) / $calls;
+    }
+    sort($results);
+
+    return $results[intdiv($samples, 2)];
+}
+
+$options = getopt('', ['json:', 'max-size:', 'time:', 'samples:', 'filter:', 'help']);
+
+if (isset($options['help'])) {
+    echo "Usage: php benchmarks/run.php [--json=FILE] [--max-size=SIZE] [--time=SECONDS] [--samples=N] [--filter=REGEX]\n";
+    exit(0);
+}
+
+if (!extension_loaded('crc_fast')) {
+    fwrite(STDERR, "The crc_fast extension is not loaded\n");
+    exit(1);
+}
+
+$maxSize = parse_size($options['max-size'] ?? '1G');
+$time = (float)($options['time'] ?? 0.1);
+$samples = max(1, (int)($options['samples'] ?? 5));
+$filter = $options['filter'] ?? null;
+
+if ($time <= 0) {
+    fwrite(STDERR, "--time must be positive\n");
+    exit(1);
+}
+
+if ($filter !== null && @preg_match($filter, '') === false) {
+    $filter = '/' . str_replace('/', '\/', $filter) . '/';
+}
+
+$sizes = array_values(array_filter(SIZES, fn(int $size) => $size <= $maxSize));
+
+$results = [];
+
+$run = function (string $group, string $name, ?int $size, callable $fn) use ($time, $samples, $filter, &$results) {
+    if ($filter !== null && !preg_match($filter, "$group/$name")) {
+        return;
+    }
+
+    $ns = measure($fn, $time, $samples);
+    $bytesPerSecond = $size > 0 ? $size / ($ns / 1e9) : null;
+
+    printf(
+        "%-10s %-44s %10s %14.1f %14s\n",
+        $group,
+        $name,
+        $size === null ? '-' : format_size($size),
+        $ns,
+        format_rate($bytesPerSecond)
+    );
+
+    $results[] = [
+        'group'         => $group,
+        'name'          => $name,
+        'size'          => $size,
+        'ns_per_op'     => round($ns, 3),
+        'bytes_per_sec' => $bytesPerSecond === null ? null : round($bytesPerSecond),
+    ];
+};
+
+printf(
+    "crc_fast %s, PHP %s, %s %s\n\n",
+    phpversion('crc_fast'),
+    PHP_VERSION,
+    PHP_OS_FAMILY,
+    php_uname('m')
+);
+printf("%-10s %-44s %10s %14s %14s\n", 'group', 'case', 'size', 'ns/op', 'throughput');
+
+// one-shot hashing of in-memory data, against PHP's own CRC-32 implementations
+foreach ($sizes as $size) {
+    $data = payload($size);
+
+    $run('hash', 'CrcFast\hash(CRC_32_ISCSI)', $size, fn() => CrcFast\hash(CrcFast\CRC_32_ISCSI, $data));
+    $run('hash', 'hash(\'crc32c\')', $size, fn() => hash('crc32c', $data));
+    $run('hash', 'CrcFast\hash(CRC_32_ISO_HDLC)', $size, fn() => CrcFast\hash(CrcFast\CRC_32_ISO_HDLC, $data));
+    $run('hash', 'hash(\'crc32b\')', $size, fn() => hash('crc32b', $data));
+    $run('hash', 'CrcFast\hash(CRC_64_NVME)', $size, fn() => CrcFast\hash(CrcFast\CRC_64_NVME, $data));
+    $run('hash', 'CrcFast\hash_int(CRC_64_NVME)', $size, fn() => CrcFast\hash_int(CrcFast\CRC_64_NVME, $data));
+    $run('crc32', 'CrcFast\crc32()', $size, fn() => CrcFast\crc32($data));
+    $run('crc32', 'crc32()', $size, fn() => \crc32($data));
+
+    unset($data);
+}
+
+// streaming through a Digest, in chunks of various sizes
+$data = payload(min(16 * MIB, $maxSize));
+$length = strlen($data);
+foreach (CHUNK_SIZES as $chunkSize) {
+    if ($chunkSize > $length) {
+        break;
+    }
+
+    $run('digest', 'Digest::update(CRC_64_NVME) ' . format_size($chunkSize) . ' chunks', $length,
+        function () use ($data, $length, $chunkSize) {
+            $digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+            for ($offset = 0; $offset < $length; $offset += $chunkSize) {
+                $digest->update($data, $offset, min($chunkSize, $length - $offset));
+            }
+
+            return $digest->finalize();
+        });
+    // the same algorithm through ext/hash, via our backend and PHP's own
+    foreach (['crc32iscsi', 'crc32c'] as $algo) {
+        $run('digest', "hash_update('$algo') " . format_size($chunkSize) . ' chunks', $length,
+            function () use ($algo, $data, $length, $chunkSize) {
+                $context = hash_init($algo);
+                for ($offset = 0; $offset < $length; $offset += $chunkSize) {
+                    hash_update($context, substr($data, $offset, $chunkSize));
+                }
+
+                return hash_final($context);
+            });
+    }
+}
+unset($data);
+
+// combining checksums is independent of the data size, but not of the length of the second part
+$checksum1 = CrcFast\hash(CrcFast\CRC_64_NVME, 'hello');
+$checksum2 = CrcFast\hash(CrcFast\CRC_64_NVME, 'world');
+$binary1 = hex2bin($checksum1);
+$binary2 = hex2bin($checksum2);
+foreach ([1, KIB, MIB, GIB] as $length2) {
+    $run('combine', 'combine(CRC_64_NVME) hex, length2 ' . format_size($length2), null,
+        fn() => CrcFast\combine(CrcFast\CRC_64_NVME, $checksum1, $checksum2, $length2));
+    $run('combine', 'combine(CRC_64_NVME) binary, length2 ' . format_size($length2), null,
+        fn() => CrcFast\combine(CrcFast\CRC_64_NVME, $binary1, $binary2, $length2, true));
+}
+
+// custom parameters, with and without pre-computed keys
+$keys = (new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888))->getKeys();
+$run('params', 'new Params(CRC-64/NVME)', null,
+    fn() => new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888));
+$run('params', 'new Params(CRC-64/NVME) with keys', null,
+    fn() => new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888, $keys));
+$run('params', 'new Params(CRC-32/ISCSI)', null,
+    fn() => new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283));
+
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+foreach (array_filter($sizes, fn(int $size) => $size <= MIB) as $size) {
+    $data = payload($size);
+    $run('params', 'CrcFast\hash(Params CRC-64/NVME)', $size, fn() => CrcFast\hash($params, $data));
+}
+unset($data, $params);
+
+// hashing files, with the page cache already warm
+$path = tempnam(sys_get_temp_dir(), 'crc_fast_bench_');
+register_shutdown_function(fn() => @unlink($path));
+foreach ($sizes as $size) {
+    $file = fopen($path, 'wb');
+    for ($written = 0; $written < $size; $written += MIB) {
+        fwrite($file, payload(min(MIB, $size - $written)));
+    }
+    fclose($file);
+
+    $run('file', 'CrcFast\hash_file(CRC_32_ISCSI)', $size, fn() => CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path));
+    $run('file', 'hash_file(\'crc32iscsi\')', $size, fn() => hash_file('crc32iscsi', $path));
+    $run('file', 'hash_file(\'crc32c\')', $size, fn() => hash_file('crc32c', $path));
+    $run('file', 'CrcFast\hash_file(CRC_64_NVME)', $size, fn() => CrcFast\hash_file(CrcFast\CRC_64_NVME, $path));
+}
+
+if (isset($options['json'])) {
+    $json = json_encode([
+        'meta'    => [
+            'crc_fast' => phpversion('crc_fast'),
+            'php'      => PHP_VERSION,
+            'os'       => PHP_OS_FAMILY,
+            'machine'  => php_uname('m'),
+            'host'     => php_uname('n'),
+            'date'     => date(DATE_ATOM),
+            'time'     => $time,
+            'samples'  => $samples,
+        ],
+        'results' => $results,
+    ], JSON_PRETTY_PRINT | JSON_UNESCAPED_SLASHES);
+
+    if (file_put_contents($options['json'], $json . "\n") === false) {
+        fwrite(STDERR, "Unable to write {$options['json']}\n");
+        exit(1);
+    }
+
+    echo "\nWrote " . count($results) . " results to {$options['json']}\n";
+}
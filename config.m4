@@ -63,6 +63,17 @@ if test "$PHP_CRC_FAST" != "no"; then
    -L$LIBCRC_FAST_DIR/lib -lm
   ])
 
+  dnl # hash_file_parallel() uses std::thread
+  PHP_ADD_LIBRARY(pthread,, CRC_FAST_SHARED_LIBADD)
+
+  dnl # hash_file()'s CrcFast\IO_URING mode uses liburing, if it's available
+  AC_CHECK_HEADER([liburing.h], [
+    PHP_CHECK_LIBRARY(uring, io_uring_queue_init, [
+      PHP_ADD_LIBRARY(uring,, CRC_FAST_SHARED_LIBADD)
+      AC_DEFINE(HAVE_CRC_FAST_IO_URING, 1, [whether liburing is available for CrcFast\IO_URING])
+    ])
+  ])
+
   PHP_SUBST(CRC_FAST_SHARED_LIBADD)
 
   dnl Mark symbols hidden by default if the compiler (for example, gcc >= 4)
@@ -76,6 +87,9 @@ if test "$PHP_CRC_FAST" != "no"; then
   [php_crc_fast.cpp],
     $ext_shared,, "-std=c++17 -DZEND_ENABLE_STATIC_TSRMLS_CACHE=1 -DCRC_FAST_EXCEPTIONS=0 -DCRC_FAST_DEVELOPMENT_CHECKS=0", cxx)
 
+  dnl Registers its algorithms as ext/hash backends
+  PHP_ADD_EXTENSION_DEP(crc_fast, hash)
+
   PHP_INSTALL_HEADERS([ext/crc_fast], [php_crc_fast.h])
   PHP_ADD_MAKEFILE_FRAGMENT
   PHP_ADD_BUILD_DIR(src, 1)
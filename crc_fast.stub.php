@@ -76,6 +76,42 @@ namespace CrcFast {
     /** @var int */
     const CRC_64_XZ = 20060;
 
+    /** @var int Lowercase hex, the default */
+    const FORMAT_HEX = 0;
+
+    /** @var int Big-endian bytes, same as $binary = true */
+    const FORMAT_BINARY = 1;
+
+    /** @var int Uppercase hex */
+    const FORMAT_HEX_UPPER = 2;
+
+    /** @var int Little-endian bytes */
+    const FORMAT_BINARY_LE = 3;
+
+    /** @var int Base64 of the big-endian bytes, e.g. for S3's x-amz-checksum-* headers */
+    const FORMAT_BASE64 = 4;
+
+    /** @var int Integer, as hash_int() */
+    const FORMAT_INT = 5;
+
+    /** @var int Let the library read plain files, and stream wrappers read anything else, the default */
+    const IO_DEFAULT = 0;
+
+    /** @var int Sequential reads, dropping each chunk from the page cache once it's hashed */
+    const IO_BUFFERED = 1;
+
+    /** @var int Memory-maps the file */
+    const IO_MMAP = 2;
+
+    /** @var int Reads with O_DIRECT into aligned buffers, bypassing the page cache */
+    const IO_DIRECT = 3;
+
+    /**
+     * @var int Keeps $queue_depth reads in flight with io_uring, only on Linux builds with liburing, falling back to
+     *     IO_BUFFERED where the kernel refuses io_uring
+     */
+    const IO_URING = 4;
+
     /**
      * Custom CRC parameters class for defining custom CRC algorithms.
      */
@@ -182,26 +218,242 @@ namespace CrcFast {
      * @param int|Params $algorithm
      * @param string     $data
      * @param bool       $binary Output binary string or hex?
+     * @param int|null   $format Output format, one of the FORMAT_* constants, overrides $binary
+     * @param int        $offset Byte offset into $data to start at, without copying it like substr() would
+     * @param int|null   $length Number of bytes to hash, defaults to the rest of $data
+     *
+     * @return string|int
+     *
+     * @frameless-function {"arity": 2}
+     * @frameless-function {"arity": 3}
+     */
+    function hash(
+        int|Params $algorithm,
+        string $data,
+        bool $binary = false,
+        ?int $format = null,
+        int $offset = 0,
+        ?int $length = null
+    ): string|int {
+    }
+
+    /**
+     * Calculates the CRC checksum of the given data, as an integer.
+     *
+     * CRC-64 checksums use all 64 bits of the integer, so ones with the top bit set are negative. On 32-bit platforms,
+     * only CRC-32 checksums can be returned.
+     *
+     * @param int|Params $algorithm
+     * @param string     $data
+     *
+     * @return int
+     */
+    function hash_int(int|Params $algorithm, string $data): int
+    {
+    }
+
+    /**
+     * Calculates the CRC checksums of each of the given strings.
+     *
+     * Much cheaper than calling hash() in a loop for lots of small inputs, since the algorithm is only resolved once.
+     *
+     * @param int|Params    $algorithm
+     * @param array<string> $data
+     * @param bool          $binary Output binary strings or hex?
+     * @param int|null      $format Output format, one of the FORMAT_* constants, overrides $binary
      *
-     * @return string
+     * @return array<string|int> Checksums, with the same keys as $data
      */
-    function hash(int|Params $algorithm, string $data, bool $binary = false): string
+    function hash_many(int|Params $algorithm, array $data, bool $binary = false, ?int $format = null): array
+    {
+    }
+
+    /**
+     * Calculates the CRC checksum of each $chunk_size part of the given data, plus of the whole data.
+     *
+     * The whole checksum is combined from the parts, so nothing is hashed twice. There can be at most 1048576 parts.
+     *
+     * @param int|Params $algorithm
+     * @param string     $data
+     * @param int        $chunk_size Size of each part, the last part may be shorter
+     * @param bool       $binary     Output binary strings or hex?
+     * @param bool       $packed     Return the part checksums as one string of big-endian binary checksums?
+     * @param int|null   $format     Output format, one of the FORMAT_* constants, overrides $binary (not $packed)
+     *
+     * @return array{chunks: array<string|int>|string, checksum: string|int}
+     */
+    function hash_chunks(
+        int|Params $algorithm,
+        string $data,
+        int $chunk_size,
+        bool $binary = false,
+        bool $packed = false,
+        ?int $format = null
+    ): array {
+    }
+
+    /**
+     * Calculates several CRC checksums of the given data in a single pass.
+     *
+     * Each cache-sized chunk of the data is fed to every algorithm before moving on to the next, so large inputs are
+     * only read from memory once.
+     *
+     * @param array<int|Params> $algorithms
+     * @param string            $data
+     * @param bool              $binary Output binary strings or hex?
+     * @param int|null          $format Output format, one of the FORMAT_* constants, overrides $binary
+     *
+     * @return array<string|int> Checksums, with the same keys as $algorithms
+     */
+    function hash_multi(array $algorithms, string $data, bool $binary = false, ?int $format = null): array
     {
     }
 
     /**
      * Calculates the CRC checksum of the given file.
      *
+     * Plain files are read directly by the library, anything else (phar://, compress.zlib://, php://, custom
+     * wrappers, etc) or any file when $chunk_size is given, is read through PHP's stream wrappers. Any $io_mode
+     * other than IO_DEFAULT reads the plain file itself that way instead, $chunk_size bytes at a time.
+     *
      * @param int|Params $algorithm
      * @param string     $filename
-     * @param bool       $binary Output binary string or hex?
+     * @param bool       $binary     Output binary string or hex?
+     * @param int|null   $chunk_size  Bytes to read at a time, defaults to 1MiB, at most 64MiB for IO_BUFFERED, IO_DIRECT and IO_URING
+     * @param int|null   $format      Output format, one of the FORMAT_* constants, overrides $binary
+     * @param int|null   $io_mode     How to read plain files, one of the IO_* constants
+     * @param int|null   $queue_depth Reads to keep in flight for IO_URING, defaults to 8
+     *
+     * @return string|int
+     */
+    function hash_file(
+        int|Params $algorithm,
+        string $filename,
+        bool $binary = false,
+        ?int $chunk_size = null,
+        ?int $format = null,
+        ?int $io_mode = null,
+        ?int $queue_depth = null
+    ): string|int {
+    }
+
+    /**
+     * Calculates the CRC checksum of the given file, using several threads.
+     *
+     * The file is split into ranges which are read and checksummed concurrently, then combined. Only plain files are
+     * supported.
+     *
+     * @param int|Params $algorithm
+     * @param string     $filename
+     * @param bool       $binary  Output binary string or hex?
+     * @param int|null   $threads Maximum number of threads, defaults to the number of CPUs
+     * @param int|null   $format  Output format, one of the FORMAT_* constants, overrides $binary
      *
-     * @return string
+     * @return string|int
      */
-    function hash_file(int|Params $algorithm, string $filename, bool $binary = false): string
+    function hash_file_parallel(
+        int|Params $algorithm,
+        string $filename,
+        bool $binary = false,
+        ?int $threads = null,
+        ?int $format = null
+    ): string|int {
+    }
+
+    /**
+     * Calculates the CRC checksums of lots of files, using a pool of threads which each take whole files.
+     *
+     * Only plain files are supported, and open_basedir applies to each of them. A file which can't be hashed doesn't
+     * stop the rest, it gets an Exception in place of its checksum instead.
+     *
+     * Options:
+     * - threads: Maximum number of threads, defaults to the number of CPUs
+     * - binary:  Output binary strings or hex?
+     * - format:  Output format, one of the FORMAT_* constants, overrides binary
+     *
+     * @param int|Params    $algorithm
+     * @param array<string> $paths
+     * @param array         $options
+     *
+     * @return array<string, string|int|\Exception> Checksums, keyed by path
+     */
+    function hash_files(int|Params $algorithm, array $paths, array $options = []): array
     {
     }
 
+    /**
+     * Calculates the CRC checksum of $length bytes of the given file, starting at $offset.
+     *
+     * The range is read with pread() straight into the library, so only plain files are supported.
+     *
+     * @param int|Params $algorithm
+     * @param string     $filename
+     * @param int        $offset Byte offset to start at
+     * @param int|null   $length Number of bytes to hash, defaults to the rest of the file
+     * @param bool       $binary Output binary string or hex?
+     * @param int|null   $format Output format, one of the FORMAT_* constants, overrides $binary
+     *
+     * @return string|int
+     */
+    function hash_file_range(
+        int|Params $algorithm,
+        string $filename,
+        int $offset,
+        ?int $length = null,
+        bool $binary = false,
+        ?int $format = null
+    ): string|int {
+    }
+
+    /**
+     * Starts calculating the CRC checksum of the given file on a background thread, returning straight away.
+     *
+     * The file is opened before returning, so missing files throw here rather than from PendingHash::result(). Only
+     * plain files are supported.
+     *
+     * Each process runs at most 16 of these at once, on a shared pool of threads, and queues the rest in the order
+     * they were started.
+     *
+     * @param int|Params $algorithm
+     * @param string     $filename
+     * @param bool       $binary Output binary string or hex?
+     * @param int|null   $format Output format, one of the FORMAT_* constants, overrides $binary
+     *
+     * @return PendingHash
+     */
+    function hash_file_async(
+        int|Params $algorithm,
+        string $filename,
+        bool $binary = false,
+        ?int $format = null
+    ): PendingHash {
+    }
+
+    /**
+     * Calculates the CRC checksum of each $chunk_size part of the given file, plus of the whole file.
+     *
+     * Works like hash_chunks(), reading the file through PHP's stream wrappers. Files too big for 1048576 parts are
+     * rejected before they're read.
+     *
+     * @param int|Params $algorithm
+     * @param string     $filename
+     * @param int        $chunk_size Size of each part, the last part may be shorter
+     * @param bool       $binary     Output binary strings or hex?
+     * @param bool       $packed     Return the part checksums as one string of big-endian binary checksums?
+     * @param int|null   $format     Output format, one of the FORMAT_* constants, overrides $binary (not $packed)
+     *
+     * @return array{chunks: array<string|int>|string, checksum: string|int}
+     */
+    function hash_file_chunks(
+        int|Params $algorithm,
+        string $filename,
+        int $chunk_size,
+        bool $binary = false,
+        bool $packed = false,
+        ?int $format = null
+    ): array {
+    }
+
     /**
      * Gets a list of supported algorithms.
      *
@@ -211,6 +463,63 @@ namespace CrcFast {
     {
     }
 
+    /**
+     * Gets the parameters of an algorithm, and the target the library accelerates it with on this machine.
+     *
+     * The id, name and supported_name are null for a CrcFast\Params object, and hash_name is null for any custom
+     * algorithm. The check value is the checksum of "123456789", as returned by hash_int().
+     *
+     * As with hash_int() and the Params getters, CRC-64 poly, init, xorout and check values use all 64 bits of the int
+     * as two's complement, so those with the top bit set are negative (e.g. CRC-64/XZ's xorout is -1), and
+     * sprintf('%016x') gives the usual hex form. They can be passed back to new Params() as they are.
+     *
+     * @return array{id: ?int, name: ?string, width: int, poly: int, init: int, refin: bool, refout: bool,
+     *     xorout: int, check: int, reverse_bytes: bool, supported_name: ?string, hash_name: ?string, target: string}
+     */
+    function get_algorithm_info(int|Params $algorithm): array
+    {
+    }
+
+    /**
+     * Gets statistics for the process-wide cache of custom CrcFast\Params keys.
+     *
+     * @return array{hits: int, misses: int, entries: int}
+     */
+    function get_params_cache_stats(): array
+    {
+    }
+
+    /**
+     * Gets the runtime statistics of this process since it started or reset_stats() was last called, if enabled with
+     * the crc_fast.stats INI setting.
+     *
+     * Counters are per algorithm ("custom" for CrcFast\Params and custom algorithms) and entry point, with time only
+     * counted if crc_fast.stats_timing is also on. The histogram counts calls by size, keyed by the smallest size in
+     * each bucket.
+     *
+     * @return array{
+     *     enabled: bool,
+     *     timing: bool,
+     *     calls: int,
+     *     bytes: int,
+     *     ns: int,
+     *     algorithms: array<string, array<string, array{calls: int, bytes: int, ns: int}>>,
+     *     histogram: array<int, int>
+     * }
+     */
+    function get_stats(): array
+    {
+    }
+
+    /**
+     * Resets the runtime statistics returned by get_stats(), for every thread in this process.
+     *
+     * @return void
+     */
+    function reset_stats(): void
+    {
+    }
+
     /**
      * Combines two CRC checksums into one.
      *
@@ -219,16 +528,60 @@ namespace CrcFast {
      * @param string     $checksum2 The second checksum to combine (binary or hex)
      * @param int        $length2   The length of the _input_ to the second checksum
      * @param bool       $binary    Output binary string or hex?
+     * @param int|null   $format    Output format, one of the FORMAT_* constants, overrides $binary
      *
-     * @return string
+     * @return string|int
      */
     function combine(
         int|Params $algorithm,
         string $checksum1,
         string $checksum2,
         int $length2,
-        bool $binary = false
-    ): string {
+        bool $binary = false,
+        ?int $format = null
+    ): string|int {
+    }
+
+    /**
+     * Combines any number of CRC checksums into one, in order.
+     *
+     * Each part is a [checksum, length] pair, with the checksum as returned by hash() or hash_int() (int, binary, hex
+     * or base64), and the length of the _input_ to that checksum.
+     *
+     * @param int|Params $algorithm
+     * @param array      $parts
+     * @param bool       $binary Output binary string or hex?
+     * @param int|null   $format Output format, one of the FORMAT_* constants, overrides $binary
+     *
+     * @return string|int
+     */
+    function combine_many(int|Params $algorithm, array $parts, bool $binary = false, ?int $format = null): string|int
+    {
+    }
+
+    /**
+     * Checks whether the CRC checksum of the given data matches an expected one, without building a result string.
+     *
+     * @param int|Params $algorithm
+     * @param string     $data
+     * @param string|int $expected As returned by hash() or hash_int(): int, binary, hex (either case) or base64
+     *
+     * @return bool
+     */
+    function verify(int|Params $algorithm, string $data, string|int $expected): bool
+    {
+    }
+
+    /**
+     * Checks whether the CRC checksum of each piece of data matches an expected one, like verify().
+     *
+     * @param int|Params $algorithm
+     * @param array      $pairs [data, expected] pairs
+     *
+     * @return array<bool> Whether each pair matches, with the same keys as $pairs
+     */
+    function verify_many(int|Params $algorithm, array $pairs): array
+    {
     }
 
     /**
@@ -237,6 +590,8 @@ namespace CrcFast {
      * @param string $data
      *
      * @return int
+     *
+     * @frameless-function {"arity": 1}
      */
     function crc32(string $data): int
     {
@@ -257,33 +612,61 @@ namespace CrcFast {
         /**
          * Updates the checksum state with the given data.
          *
-         * @param string $data
+         * @param string   $data
+         * @param int      $offset Byte offset into $data to start at, without copying it like substr() would
+         * @param int|null $length Number of bytes to add, defaults to the rest of $data
          *
          * @return Digest
          */
-        public function update(string $data): Digest
+        public function update(string $data, int $offset = 0, ?int $length = null): Digest
+        {
+        }
+
+        /**
+         * Updates the checksum state with data read from the given stream, without copying it into PHP strings.
+         *
+         * Reads until EOF, or until $length bytes have been read.
+         *
+         * @param resource $stream
+         * @param int|null $length    Maximum number of bytes to read, or null to read until EOF
+         * @param int      $chunkSize Bytes to read at a time
+         *
+         * @return int The number of bytes read
+         */
+        public function updateStream($stream, ?int $length = null, int $chunkSize = 1048576): int
         {
         }
 
         /**
          * Returns the computed checksum.
          *
-         * @param bool $binary Output binary string or hex?
+         * @param bool     $binary Output binary string or hex?
+         * @param int|null $format Output format, one of the FORMAT_* constants, overrides $binary
          *
-         * @return string
+         * @return string|int
          */
-        public function finalize(bool $binary = false): string
+        public function finalize(bool $binary = false, ?int $format = null): string|int
         {
         }
 
         /**
          * Returns  the computed checksum, plus resets the internal state.
          *
-         * @param bool $binary Output binary string or hex?
+         * @param bool     $binary Output binary string or hex?
+         * @param int|null $format Output format, one of the FORMAT_* constants, overrides $binary
          *
-         * @return string
+         * @return string|int
          */
-        public function finalizeReset(bool $binary = false): string
+        public function finalizeReset(bool $binary = false, ?int $format = null): string|int
+        {
+        }
+
+        /**
+         * Returns the computed checksum as an integer, with the same layout as hash_int().
+         *
+         * @return int
+         */
+        public function finalizeInt(): int
         {
         }
 
@@ -306,5 +689,135 @@ namespace CrcFast {
         public function combine(Digest $digest): Digest
         {
         }
+
+        /**
+         * Exports the state of the checksum so far, so it can be resumed later or elsewhere.
+         *
+         * @return array
+         */
+        public function __serialize(): array
+        {
+        }
+
+        /**
+         * Restores the state of the checksum from the output of __serialize().
+         *
+         * @param array $data
+         *
+         * @return void
+         */
+        public function __unserialize(array $data): void
+        {
+        }
+    }
+
+    /**
+     * Digest class for calculating several CRC checksums of the same data in a single pass.
+     */
+    class MultiDigest
+    {
+        /**
+         * @param array<int|Params> $algorithms
+         */
+        public function __construct(array $algorithms)
+        {
+        }
+
+        /**
+         * Updates the state of every checksum with the given data.
+         *
+         * @param string $data
+         *
+         * @return MultiDigest
+         */
+        public function update(string $data): MultiDigest
+        {
+        }
+
+        /**
+         * Returns the computed checksums, with the same keys as the algorithms given to the constructor.
+         *
+         * @param bool     $binary Output binary strings or hex?
+         * @param int|null $format Output format, one of the FORMAT_* constants, overrides $binary
+         *
+         * @return array<string|int>
+         */
+        public function finalize(bool $binary = false, ?int $format = null): array
+        {
+        }
+
+        /**
+         * Returns the computed checksums, plus resets the internal state.
+         *
+         * @param bool     $binary Output binary strings or hex?
+         * @param int|null $format Output format, one of the FORMAT_* constants, overrides $binary
+         *
+         * @return array<string|int>
+         */
+        public function finalizeReset(bool $binary = false, ?int $format = null): array
+        {
+        }
+
+        /**
+         * Resets the internal state of every checksum.
+         *
+         * @return MultiDigest
+         */
+        public function reset(): MultiDigest
+        {
+        }
+    }
+
+    /**
+     * A file being hashed on a background thread, see hash_file_async().
+     *
+     * @strict-properties
+     * @not-serializable
+     */
+    final class PendingHash
+    {
+        private function __construct()
+        {
+        }
+
+        /**
+         * Whether the checksum is ready, without blocking.
+         *
+         * @return bool
+         */
+        public function isDone(): bool
+        {
+        }
+
+        /**
+         * Blocks until the checksum is ready, or $timeout seconds have passed.
+         *
+         * @param float|null $timeout Seconds to wait for, or null to wait as long as it takes
+         *
+         * @return bool Whether the checksum is ready
+         */
+        public function wait(?float $timeout = null): bool
+        {
+        }
+
+        /**
+         * Returns the checksum, in the format given to hash_file_async(), blocking until it's ready.
+         *
+         * @return string|int
+         */
+        public function result(): string|int
+        {
+        }
+
+        /**
+         * Returns a stream which becomes readable once the checksum is ready, for stream_select() and event loops.
+         *
+         * Not available on Windows.
+         *
+         * @return resource
+         */
+        public function getStream()
+        {
+        }
     }
 }
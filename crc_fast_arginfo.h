@@ -1,27 +1,131 @@
 /* This is a generated file, edit the .stub.php file instead.
- * Stub hash: 96eb8b181c4a140e8c3740856b2c851cbfc30cbb */
+ * Stub hash: 2a835b86cef485d2193bd921a98bea2da8bbea4f */
 
-ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash, 0, 2, IS_STRING, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_CrcFast_hash, 0, 2, MAY_BE_STRING|MAY_BE_LONG)
 	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
 	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, offset, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, length, IS_LONG, 1, "null")
 ZEND_END_ARG_INFO()
 
-ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_file, 0, 2, IS_STRING, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_int, 0, 2, IS_LONG, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_many, 0, 2, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, data, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_chunks, 0, 3, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, chunk_size, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, packed, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_multi, 0, 2, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, algorithms, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_CrcFast_hash_file, 0, 2, MAY_BE_STRING|MAY_BE_LONG)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, filename, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, chunk_size, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, io_mode, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, queue_depth, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_CrcFast_hash_file_parallel, 0, 2, MAY_BE_STRING|MAY_BE_LONG)
 	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
 	ZEND_ARG_TYPE_INFO(0, filename, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, threads, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_files, 0, 2, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, paths, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, options, IS_ARRAY, 0, "[]")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_CrcFast_hash_file_range, 0, 3, MAY_BE_STRING|MAY_BE_LONG)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, filename, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, offset, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, length, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_CrcFast_hash_file_async, 0, 2, CrcFast\\PendingHash, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, filename, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_hash_file_chunks, 0, 3, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, filename, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO(0, chunk_size, IS_LONG, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, packed, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_get_supported_algorithms, 0, 0, IS_ARRAY, 0)
 ZEND_END_ARG_INFO()
 
-ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_combine, 0, 4, IS_STRING, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_get_algorithm_info, 0, 1, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+ZEND_END_ARG_INFO()
+
+#define arginfo_CrcFast_get_params_cache_stats arginfo_CrcFast_get_supported_algorithms
+
+#define arginfo_CrcFast_get_stats arginfo_CrcFast_get_supported_algorithms
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_reset_stats, 0, 0, IS_VOID, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_CrcFast_combine, 0, 4, MAY_BE_STRING|MAY_BE_LONG)
 	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
 	ZEND_ARG_TYPE_INFO(0, checksum1, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO(0, checksum2, IS_STRING, 0)
 	ZEND_ARG_TYPE_INFO(0, length2, IS_LONG, 0)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_CrcFast_combine_many, 0, 2, MAY_BE_STRING|MAY_BE_LONG)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, parts, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_verify, 0, 3, _IS_BOOL, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+	ZEND_ARG_TYPE_MASK(0, expected, MAY_BE_STRING|MAY_BE_LONG, NULL)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_verify_many, 0, 2, IS_ARRAY, 0)
+	ZEND_ARG_OBJ_TYPE_MASK(0, algorithm, CrcFast\\Params, MAY_BE_LONG, NULL)
+	ZEND_ARG_TYPE_INFO(0, pairs, IS_ARRAY, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_CrcFast_crc32, 0, 1, IS_LONG, 0)
@@ -63,14 +167,26 @@ ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_CrcFast_Digest_update, 0, 1, CrcFast\\Digest, 0)
 	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, offset, IS_LONG, 0, "0")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, length, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_Digest_updateStream, 0, 1, IS_LONG, 0)
+	ZEND_ARG_INFO(0, stream)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, length, IS_LONG, 1, "null")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, chunkSize, IS_LONG, 0, "1048576")
 ZEND_END_ARG_INFO()
 
-ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_Digest_finalize, 0, 0, IS_STRING, 0)
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_class_CrcFast_Digest_finalize, 0, 0, MAY_BE_STRING|MAY_BE_LONG)
 	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
 ZEND_END_ARG_INFO()
 
 #define arginfo_class_CrcFast_Digest_finalizeReset arginfo_class_CrcFast_Digest_finalize
 
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_Digest_finalizeInt, 0, 0, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_CrcFast_Digest_reset, 0, 0, CrcFast\\Digest, 0)
 ZEND_END_ARG_INFO()
 
@@ -78,11 +194,82 @@ ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_CrcFast_Digest_combine, 0,
 	ZEND_ARG_OBJ_INFO(0, digest, CrcFast\\Digest, 0)
 ZEND_END_ARG_INFO()
 
+#define arginfo_class_CrcFast_Digest___serialize arginfo_CrcFast_get_supported_algorithms
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_Digest___unserialize, 0, 1, IS_VOID, 0)
+	ZEND_ARG_TYPE_INFO(0, data, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_CrcFast_MultiDigest___construct, 0, 0, 1)
+	ZEND_ARG_TYPE_INFO(0, algorithms, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_CrcFast_MultiDigest_update, 0, 1, CrcFast\\MultiDigest, 0)
+	ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_MultiDigest_finalize, 0, 0, IS_ARRAY, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, binary, _IS_BOOL, 0, "false")
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, format, IS_LONG, 1, "null")
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_CrcFast_MultiDigest_finalizeReset arginfo_class_CrcFast_MultiDigest_finalize
+
+ZEND_BEGIN_ARG_WITH_RETURN_OBJ_INFO_EX(arginfo_class_CrcFast_MultiDigest_reset, 0, 0, CrcFast\\MultiDigest, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_class_CrcFast_PendingHash___construct, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_PendingHash_isDone, 0, 0, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_INFO_EX(arginfo_class_CrcFast_PendingHash_wait, 0, 0, _IS_BOOL, 0)
+	ZEND_ARG_TYPE_INFO_WITH_DEFAULT_VALUE(0, timeout, IS_DOUBLE, 1, "null")
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_WITH_RETURN_TYPE_MASK_EX(arginfo_class_CrcFast_PendingHash_result, 0, 0, MAY_BE_STRING|MAY_BE_LONG)
+ZEND_END_ARG_INFO()
+
+#define arginfo_class_CrcFast_PendingHash_getStream arginfo_class_CrcFast_PendingHash___construct
+
+#if (PHP_VERSION_ID >= 80400)
+ZEND_FRAMELESS_FUNCTION(CrcFast_hash, 2);
+ZEND_FRAMELESS_FUNCTION(CrcFast_hash, 3);
+static const zend_frameless_function_info frameless_function_infos_CrcFast_hash[] = {
+	{ ZEND_FRAMELESS_FUNCTION_NAME(CrcFast_hash, 2), 2 },
+	{ ZEND_FRAMELESS_FUNCTION_NAME(CrcFast_hash, 3), 3 },
+	{ 0 },
+};
+
+ZEND_FRAMELESS_FUNCTION(CrcFast_crc32, 1);
+static const zend_frameless_function_info frameless_function_infos_CrcFast_crc32[] = {
+	{ ZEND_FRAMELESS_FUNCTION_NAME(CrcFast_crc32, 1), 1 },
+	{ 0 },
+};
+#endif
+
 
 ZEND_FUNCTION(CrcFast_hash);
+ZEND_FUNCTION(CrcFast_hash_int);
+ZEND_FUNCTION(CrcFast_hash_many);
+ZEND_FUNCTION(CrcFast_hash_chunks);
+ZEND_FUNCTION(CrcFast_hash_multi);
 ZEND_FUNCTION(CrcFast_hash_file);
+ZEND_FUNCTION(CrcFast_hash_file_parallel);
+ZEND_FUNCTION(CrcFast_hash_files);
+ZEND_FUNCTION(CrcFast_hash_file_range);
+ZEND_FUNCTION(CrcFast_hash_file_async);
+ZEND_FUNCTION(CrcFast_hash_file_chunks);
 ZEND_FUNCTION(CrcFast_get_supported_algorithms);
+ZEND_FUNCTION(CrcFast_get_algorithm_info);
+ZEND_FUNCTION(CrcFast_get_params_cache_stats);
+ZEND_FUNCTION(CrcFast_get_stats);
+ZEND_FUNCTION(CrcFast_reset_stats);
 ZEND_FUNCTION(CrcFast_combine);
+ZEND_FUNCTION(CrcFast_combine_many);
+ZEND_FUNCTION(CrcFast_verify);
+ZEND_FUNCTION(CrcFast_verify_many);
 ZEND_FUNCTION(CrcFast_crc32);
 ZEND_METHOD(CrcFast_Params, __construct);
 ZEND_METHOD(CrcFast_Params, getWidth);
@@ -95,18 +282,56 @@ ZEND_METHOD(CrcFast_Params, getCheck);
 ZEND_METHOD(CrcFast_Params, getKeys);
 ZEND_METHOD(CrcFast_Digest, __construct);
 ZEND_METHOD(CrcFast_Digest, update);
+ZEND_METHOD(CrcFast_Digest, updateStream);
 ZEND_METHOD(CrcFast_Digest, finalize);
 ZEND_METHOD(CrcFast_Digest, finalizeReset);
+ZEND_METHOD(CrcFast_Digest, finalizeInt);
 ZEND_METHOD(CrcFast_Digest, reset);
 ZEND_METHOD(CrcFast_Digest, combine);
+ZEND_METHOD(CrcFast_Digest, __serialize);
+ZEND_METHOD(CrcFast_Digest, __unserialize);
+ZEND_METHOD(CrcFast_MultiDigest, __construct);
+ZEND_METHOD(CrcFast_MultiDigest, update);
+ZEND_METHOD(CrcFast_MultiDigest, finalize);
+ZEND_METHOD(CrcFast_MultiDigest, finalizeReset);
+ZEND_METHOD(CrcFast_MultiDigest, reset);
+ZEND_METHOD(CrcFast_PendingHash, __construct);
+ZEND_METHOD(CrcFast_PendingHash, isDone);
+ZEND_METHOD(CrcFast_PendingHash, wait);
+ZEND_METHOD(CrcFast_PendingHash, result);
+ZEND_METHOD(CrcFast_PendingHash, getStream);
 
 
 static const zend_function_entry ext_functions[] = {
+#if (PHP_VERSION_ID >= 80400)
+	ZEND_RAW_FENTRY(ZEND_NS_NAME("CrcFast", "hash"), zif_CrcFast_hash, arginfo_CrcFast_hash, 0, frameless_function_infos_CrcFast_hash, NULL)
+#else
 	ZEND_NS_FALIAS("CrcFast", hash, CrcFast_hash, arginfo_CrcFast_hash)
+#endif
+	ZEND_NS_FALIAS("CrcFast", hash_int, CrcFast_hash_int, arginfo_CrcFast_hash_int)
+	ZEND_NS_FALIAS("CrcFast", hash_many, CrcFast_hash_many, arginfo_CrcFast_hash_many)
+	ZEND_NS_FALIAS("CrcFast", hash_chunks, CrcFast_hash_chunks, arginfo_CrcFast_hash_chunks)
+	ZEND_NS_FALIAS("CrcFast", hash_multi, CrcFast_hash_multi, arginfo_CrcFast_hash_multi)
 	ZEND_NS_FALIAS("CrcFast", hash_file, CrcFast_hash_file, arginfo_CrcFast_hash_file)
+	ZEND_NS_FALIAS("CrcFast", hash_file_parallel, CrcFast_hash_file_parallel, arginfo_CrcFast_hash_file_parallel)
+	ZEND_NS_FALIAS("CrcFast", hash_files, CrcFast_hash_files, arginfo_CrcFast_hash_files)
+	ZEND_NS_FALIAS("CrcFast", hash_file_range, CrcFast_hash_file_range, arginfo_CrcFast_hash_file_range)
+	ZEND_NS_FALIAS("CrcFast", hash_file_async, CrcFast_hash_file_async, arginfo_CrcFast_hash_file_async)
+	ZEND_NS_FALIAS("CrcFast", hash_file_chunks, CrcFast_hash_file_chunks, arginfo_CrcFast_hash_file_chunks)
 	ZEND_NS_FALIAS("CrcFast", get_supported_algorithms, CrcFast_get_supported_algorithms, arginfo_CrcFast_get_supported_algorithms)
+	ZEND_NS_FALIAS("CrcFast", get_algorithm_info, CrcFast_get_algorithm_info, arginfo_CrcFast_get_algorithm_info)
+	ZEND_NS_FALIAS("CrcFast", get_params_cache_stats, CrcFast_get_params_cache_stats, arginfo_CrcFast_get_params_cache_stats)
+	ZEND_NS_FALIAS("CrcFast", get_stats, CrcFast_get_stats, arginfo_CrcFast_get_stats)
+	ZEND_NS_FALIAS("CrcFast", reset_stats, CrcFast_reset_stats, arginfo_CrcFast_reset_stats)
 	ZEND_NS_FALIAS("CrcFast", combine, CrcFast_combine, arginfo_CrcFast_combine)
+	ZEND_NS_FALIAS("CrcFast", combine_many, CrcFast_combine_many, arginfo_CrcFast_combine_many)
+	ZEND_NS_FALIAS("CrcFast", verify, CrcFast_verify, arginfo_CrcFast_verify)
+	ZEND_NS_FALIAS("CrcFast", verify_many, CrcFast_verify_many, arginfo_CrcFast_verify_many)
+#if (PHP_VERSION_ID >= 80400)
+	ZEND_RAW_FENTRY(ZEND_NS_NAME("CrcFast", "crc32"), zif_CrcFast_crc32, arginfo_CrcFast_crc32, 0, frameless_function_infos_CrcFast_crc32, NULL)
+#else
 	ZEND_NS_FALIAS("CrcFast", crc32, CrcFast_crc32, arginfo_CrcFast_crc32)
+#endif
 	ZEND_FE_END
 };
 
@@ -128,10 +353,34 @@ static const zend_function_entry class_CrcFast_Params_methods[] = {
 static const zend_function_entry class_CrcFast_Digest_methods[] = {
 	ZEND_ME(CrcFast_Digest, __construct, arginfo_class_CrcFast_Digest___construct, ZEND_ACC_PUBLIC)
 	ZEND_ME(CrcFast_Digest, update, arginfo_class_CrcFast_Digest_update, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_Digest, updateStream, arginfo_class_CrcFast_Digest_updateStream, ZEND_ACC_PUBLIC)
 	ZEND_ME(CrcFast_Digest, finalize, arginfo_class_CrcFast_Digest_finalize, ZEND_ACC_PUBLIC)
 	ZEND_ME(CrcFast_Digest, finalizeReset, arginfo_class_CrcFast_Digest_finalizeReset, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_Digest, finalizeInt, arginfo_class_CrcFast_Digest_finalizeInt, ZEND_ACC_PUBLIC)
 	ZEND_ME(CrcFast_Digest, reset, arginfo_class_CrcFast_Digest_reset, ZEND_ACC_PUBLIC)
 	ZEND_ME(CrcFast_Digest, combine, arginfo_class_CrcFast_Digest_combine, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_Digest, __serialize, arginfo_class_CrcFast_Digest___serialize, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_Digest, __unserialize, arginfo_class_CrcFast_Digest___unserialize, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+
+static const zend_function_entry class_CrcFast_MultiDigest_methods[] = {
+	ZEND_ME(CrcFast_MultiDigest, __construct, arginfo_class_CrcFast_MultiDigest___construct, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_MultiDigest, update, arginfo_class_CrcFast_MultiDigest_update, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_MultiDigest, finalize, arginfo_class_CrcFast_MultiDigest_finalize, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_MultiDigest, finalizeReset, arginfo_class_CrcFast_MultiDigest_finalizeReset, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_MultiDigest, reset, arginfo_class_CrcFast_MultiDigest_reset, ZEND_ACC_PUBLIC)
+	ZEND_FE_END
+};
+
+
+static const zend_function_entry class_CrcFast_PendingHash_methods[] = {
+	ZEND_ME(CrcFast_PendingHash, __construct, arginfo_class_CrcFast_PendingHash___construct, ZEND_ACC_PRIVATE)
+	ZEND_ME(CrcFast_PendingHash, isDone, arginfo_class_CrcFast_PendingHash_isDone, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_PendingHash, wait, arginfo_class_CrcFast_PendingHash_wait, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_PendingHash, result, arginfo_class_CrcFast_PendingHash_result, ZEND_ACC_PUBLIC)
+	ZEND_ME(CrcFast_PendingHash, getStream, arginfo_class_CrcFast_PendingHash_getStream, ZEND_ACC_PUBLIC)
 	ZEND_FE_END
 };
 
@@ -157,6 +406,17 @@ static void register_crc_fast_symbols(int module_number)
 	REGISTER_LONG_CONSTANT("CrcFast\\CRC_64_REDIS", 20040, CONST_PERSISTENT);
 	REGISTER_LONG_CONSTANT("CrcFast\\CRC_64_WE", 20050, CONST_PERSISTENT);
 	REGISTER_LONG_CONSTANT("CrcFast\\CRC_64_XZ", 20060, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\FORMAT_HEX", 0, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\FORMAT_BINARY", 1, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\FORMAT_HEX_UPPER", 2, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\FORMAT_BINARY_LE", 3, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\FORMAT_BASE64", 4, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\FORMAT_INT", 5, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\IO_DEFAULT", 0, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\IO_BUFFERED", 1, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\IO_MMAP", 2, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\IO_DIRECT", 3, CONST_PERSISTENT);
+	REGISTER_LONG_CONSTANT("CrcFast\\IO_URING", 4, CONST_PERSISTENT);
 }
 
 static zend_class_entry *register_class_CrcFast_Params(void)
@@ -178,3 +438,24 @@ static zend_class_entry *register_class_CrcFast_Digest(void)
 
 	return class_entry;
 }
+
+static zend_class_entry *register_class_CrcFast_MultiDigest(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_NS_CLASS_ENTRY(ce, "CrcFast", "MultiDigest", class_CrcFast_MultiDigest_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+
+	return class_entry;
+}
+
+static zend_class_entry *register_class_CrcFast_PendingHash(void)
+{
+	zend_class_entry ce, *class_entry;
+
+	INIT_NS_CLASS_ENTRY(ce, "CrcFast", "PendingHash", class_CrcFast_PendingHash_methods);
+	class_entry = zend_register_internal_class_ex(&ce, NULL);
+	class_entry->ce_flags |= ZEND_ACC_FINAL|ZEND_ACC_NO_DYNAMIC_PROPERTIES|ZEND_ACC_NOT_SERIALIZABLE;
+
+	return class_entry;
+}
@@ -8,14 +8,43 @@
 extern "C" {
 #include "php.h"
 #include "ext/standard/info.h"
+#include "ext/standard/base64.h"
 #include "ext/standard/file.h"
+#include "ext/hash/php_hash.h"
+#include "php_streams.h"
 #include "zend_exceptions.h"
 #include "zend_interfaces.h"
 }
 
 #include "php_crc_fast.h"
 #include "crc_fast_arginfo.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef PHP_WIN32
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+#ifdef HAVE_CRC_FAST_IO_URING
+# include <liburing.h>
+#endif
+
+#ifndef O_BINARY
+# define O_BINARY 0
+#endif
 
 // Define htonll/ntohll for platforms that don't provide them
 #if defined(_WIN32) || defined(_WIN64)
@@ -75,6 +104,14 @@ static zend_object_handlers php_crc_fast_digest_object_handlers;
 zend_class_entry *php_crc_fast_params_ce;
 static zend_object_handlers php_crc_fast_params_object_handlers;
 
+/* CrcFast\MultiDigest class */
+zend_class_entry *php_crc_fast_multi_digest_ce;
+static zend_object_handlers php_crc_fast_multi_digest_object_handlers;
+
+/* CrcFast\PendingHash class */
+zend_class_entry *php_crc_fast_pending_hash_ce;
+static zend_object_handlers php_crc_fast_pending_hash_object_handlers;
+
 /* Free the Digest object */
 static void php_crc_fast_digest_free_obj(zend_object *object)
 {
@@ -136,85 +173,346 @@ static zend_object *php_crc_fast_params_create_object(zend_class_entry *ce)
     return &obj->std;
 }
 
-/* Helper function to format checksum output */
-static inline void php_crc_fast_format_result(INTERNAL_FUNCTION_PARAMETERS, zend_long algorithm, uint64_t result, zend_bool binary, bool is_custom = false, uint8_t custom_width = 0)
+/* Free the MultiDigest entries */
+static void php_crc_fast_multi_entries_free(php_crc_fast_multi_entry *entries, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        if (entries[i].digest) {
+            crc_fast_digest_free(entries[i].digest);
+        }
+    }
+
+    efree(entries);
+}
+
+/* Free the MultiDigest object */
+static void php_crc_fast_multi_digest_free_obj(zend_object *object)
+{
+    php_crc_fast_multi_digest_obj *obj = php_crc_fast_multi_digest_from_obj(object);
+
+    if (obj->entries) {
+        php_crc_fast_multi_entries_free(obj->entries, obj->count);
+        obj->entries = NULL;
+    }
+
+    zval_ptr_dtor(&obj->algorithms);
+
+    zend_object_std_dtor(&obj->std);
+}
+
+/* Create a new MultiDigest object */
+static zend_object *php_crc_fast_multi_digest_create_object(zend_class_entry *ce)
+{
+    php_crc_fast_multi_digest_obj *obj = (php_crc_fast_multi_digest_obj*)ecalloc(1, sizeof(php_crc_fast_multi_digest_obj) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&obj->std, ce);
+    object_properties_init(&obj->std, ce);
+
+    obj->std.handlers = &php_crc_fast_multi_digest_object_handlers;
+    obj->entries = NULL;
+    obj->count = 0;
+    ZVAL_UNDEF(&obj->algorithms);
+
+    return &obj->std;
+}
+
+/* The built-in algorithms, with their catalogue parameters
+ *
+ * Ordered by constant, which is also the order of CrcFast\get_supported_algorithms(). Looked up by constant through
+ * php_crc_fast_algorithm_index, which is built at compile time, so nothing here costs more than an array access. */
+static constexpr php_crc_fast_algorithm_info php_crc_fast_algorithms[] = {
+    {PHP_CRC_FAST_CRC32_AIXM,      CrcFastAlgorithm::Crc32Aixm,     32, 0x814141AB, 0, false, false, 0,
+        0x3010BF7F, false, "CRC-32/AIXM", "CRC-32/AIXM", "crc32aixm"},
+    {PHP_CRC_FAST_CRC32_AUTOSAR,   CrcFastAlgorithm::Crc32Autosar,  32, 0xF4ACFB13, 0xFFFFFFFF, true, true, 0xFFFFFFFF,
+        0x1697D06A, false, "CRC-32/AUTOSAR", "CRC32_AUTOSAR", "crc32autosar"},
+    {PHP_CRC_FAST_CRC32_BASE91D,   CrcFastAlgorithm::Crc32Base91D,  32, 0xA833982B, 0xFFFFFFFF, true, true, 0xFFFFFFFF,
+        0x87315576, false, "CRC-32/BASE91-D", "CRC-32/BASE-91-D", "crc32base91d"},
+    {PHP_CRC_FAST_CRC32_BZIP2,     CrcFastAlgorithm::Crc32Bzip2,    32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF,
+        0xFC891918, false, "CRC-32/BZIP2", "CRC-32/BZIP2", "crc32bzip2"},
+    {PHP_CRC_FAST_CRC32_CDROM_EDC, CrcFastAlgorithm::Crc32CdRomEdc, 32, 0x8001801B, 0, true, true, 0,
+        0x6EC2EDC4, false, "CRC-32/CD-ROM-EDC", "CRC-32/CD-ROM-EDC", "crc32cdromedc"},
+    {PHP_CRC_FAST_CRC32_CKSUM,     CrcFastAlgorithm::Crc32Cksum,    32, 0x04C11DB7, 0, false, false, 0xFFFFFFFF,
+        0x765E7680, false, "CRC-32/CKSUM", "CRC-32/CKSUM", "crc32cksum"},
+    {PHP_CRC_FAST_CRC32_ISCSI,     CrcFastAlgorithm::Crc32Iscsi,    32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF,
+        0xE3069283, false, "CRC-32/ISCSI", "CRC-32/ISCSI", "crc32iscsi"},
+    {PHP_CRC_FAST_CRC32_ISO_HDLC,  CrcFastAlgorithm::Crc32IsoHdlc,  32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF,
+        0xCBF43926, false, "CRC-32/ISO-HDLC", "CRC-32/ISO_HDLC", "crc32isohdlc"},
+    {PHP_CRC_FAST_CRC32_JAMCRC,    CrcFastAlgorithm::Crc32Jamcrc,   32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0,
+        0x340BC6D9, false, "CRC-32/JAMCRC", "CRC-32/JAMCRC", "crc32jamcrc"},
+    {PHP_CRC_FAST_CRC32_MEF,       CrcFastAlgorithm::Crc32Mef,      32, 0x741B8CD7, 0xFFFFFFFF, true, true, 0,
+        0xD2C22F51, false, "CRC-32/MEF", "CRC-32/MEF", "crc32mef"},
+    {PHP_CRC_FAST_CRC32_MPEG2,     CrcFastAlgorithm::Crc32Mpeg2,    32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0,
+        0x0376E6E7, false, "CRC-32/MPEG-2", "CRC-32/MPEG-2", "crc32mpeg2"},
+    // this is a special flower, just to handle PHP's `hash('crc32')` operation,
+    // which is actually byte-reversed CRC-32/BZIP2
+    {PHP_CRC_FAST_CRC32_PHP,       CrcFastAlgorithm::Crc32Bzip2,    32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF,
+        0x181989FC, true, "CRC-32/PHP", NULL, "crc32php"},
+    {PHP_CRC_FAST_CRC32_XFER,      CrcFastAlgorithm::Crc32Xfer,     32, 0x000000AF, 0, false, false, 0,
+        0xBD0BE338, false, "CRC-32/XFER", "CRC-32/XFER", "crc32xfer"},
+    {PHP_CRC_FAST_CRC64_ECMA182,   CrcFastAlgorithm::Crc64Ecma182,  64, 0x42F0E1EBA9EA3693, 0, false, false, 0,
+        0x6C40DF5F0B497347, false, "CRC-64/ECMA-182", "CRC-64/ECMA-182", "crc64ecma182"},
+    {PHP_CRC_FAST_CRC64_GO_ISO,    CrcFastAlgorithm::Crc64GoIso,    64, 0x000000000000001B, UINT64_MAX, true, true, UINT64_MAX,
+        0xB90956C775A41001, false, "CRC-64/GO-ISO", "CRC-64/GO-ISO", "crc64goiso"},
+    {PHP_CRC_FAST_CRC64_MS,        CrcFastAlgorithm::Crc64Ms,       64, 0x259C84CBA6426349, UINT64_MAX, true, true, 0,
+        0x75D4B74F024ECEEA, false, "CRC-64/MS", "CRC-64/MS", "crc64ms"},
+    {PHP_CRC_FAST_CRC64_NVME,      CrcFastAlgorithm::Crc64Nvme,     64, 0xAD93D23594C93659, UINT64_MAX, true, true, UINT64_MAX,
+        0xAE8B14860A799888, false, "CRC-64/NVME", "CRC-64/NVME", "crc64nvme"},
+    {PHP_CRC_FAST_CRC64_REDIS,     CrcFastAlgorithm::Crc64Redis,    64, 0xAD93D23594C935A9, 0, true, true, 0,
+        0xE9C6D914C4B8D9CA, false, "CRC-64/REDIS", "CRC-64/REDIS", "crc64redis"},
+    {PHP_CRC_FAST_CRC64_WE,        CrcFastAlgorithm::Crc64We,       64, 0x42F0E1EBA9EA3693, UINT64_MAX, false, false, UINT64_MAX,
+        0x62EC59E3F1A4F00A, false, "CRC-64/WE", "CRC-64/WE", "crc64we"},
+    {PHP_CRC_FAST_CRC64_XZ,        CrcFastAlgorithm::Crc64Xz,       64, 0x42F0E1EBA9EA3693, UINT64_MAX, true, true, UINT64_MAX,
+        0x995DC9BBDF1939FA, false, "CRC-64/XZ", "CRC-64/XZ", "crc64xz"},
+};
+
+#define PHP_CRC_FAST_ALGORITHM_COUNT (sizeof(php_crc_fast_algorithms) / sizeof(php_crc_fast_algorithms[0]))
+
+/* Constants are 10000 for CRC-32 and 20000 for CRC-64, plus a multiple of 10 for each algorithm, so each width gets
+ * a run of slots indexed by (constant % 10000) / 10 */
+#define PHP_CRC_FAST_ALGORITHM_SLOTS_PER_WIDTH 32
+
+static constexpr int php_crc_fast_algorithm_slot(zend_long id)
+{
+    if (id < PHP_CRC_FAST_CRC32_AIXM || id >= PHP_CRC_FAST_CUSTOM_BASE || id % 10 != 0
+        || (id % 10000) / 10 >= PHP_CRC_FAST_ALGORITHM_SLOTS_PER_WIDTH) {
+        return -1;
+    }
+
+    return (int)((id / 10000 - 1) * PHP_CRC_FAST_ALGORITHM_SLOTS_PER_WIDTH + (id % 10000) / 10);
+}
+
+typedef struct _php_crc_fast_algorithm_index_t {
+    int8_t slots[2 * PHP_CRC_FAST_ALGORITHM_SLOTS_PER_WIDTH];  // Index into php_crc_fast_algorithms, or -1
+} php_crc_fast_algorithm_index_t;
+
+static constexpr php_crc_fast_algorithm_index_t php_crc_fast_algorithm_build_index()
+{
+    php_crc_fast_algorithm_index_t index = {};
+
+    for (size_t i = 0; i < sizeof(index.slots); i++) {
+        index.slots[i] = -1;
+    }
+
+    for (size_t i = 0; i < PHP_CRC_FAST_ALGORITHM_COUNT; i++) {
+        index.slots[php_crc_fast_algorithm_slot(php_crc_fast_algorithms[i].id)] = (int8_t)i;
+    }
+
+    return index;
+}
+
+static constexpr php_crc_fast_algorithm_index_t php_crc_fast_algorithm_index = php_crc_fast_algorithm_build_index();
+
+/* Helper function to find a built-in algorithm by its constant, NULL if there's no such algorithm */
+static constexpr const php_crc_fast_algorithm_info *php_crc_fast_find_algorithm(zend_long algorithm)
+{
+    int slot = php_crc_fast_algorithm_slot(algorithm);
+    if (slot < 0 || php_crc_fast_algorithm_index.slots[slot] < 0) {
+        return NULL;
+    }
+
+    return &php_crc_fast_algorithms[php_crc_fast_algorithm_index.slots[slot]];
+}
+
+static_assert(PHP_CRC_FAST_ALGORITHM_COUNT < INT8_MAX, "php_crc_fast_algorithm_index_t needs wider slots");
+static_assert(php_crc_fast_find_algorithm(PHP_CRC_FAST_CRC32_PHP)->reverse_bytes, "CRC-32/PHP must be found");
+static_assert(php_crc_fast_find_algorithm(PHP_CRC_FAST_CRC64_XZ)->width == 64, "CRC-64/XZ must be found");
+static_assert(php_crc_fast_find_algorithm(PHP_CRC_FAST_CUSTOM_BASE) == NULL, "custom algorithms aren't built in");
+
+static constexpr bool php_crc_fast_reverse_bytes_are_32bit()
+{
+    for (size_t i = 0; i < PHP_CRC_FAST_ALGORITHM_COUNT; i++) {
+        if (php_crc_fast_algorithms[i].reverse_bytes && php_crc_fast_algorithms[i].width != 32) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static_assert(php_crc_fast_reverse_bytes_are_32bit(), "only 32-bit byte reversal is implemented");
+
+/* Helper function to determine whether a checksum is 32 or 64 bits wide */
+static inline bool php_crc_fast_is_32bit(zend_long algorithm, bool is_custom = false, uint8_t custom_width = 0)
 {
-    bool is_32bit;
-    
     if (is_custom) {
         // For custom parameters, use the width from the parameters
-        is_32bit = (custom_width == 32);
-    } else {
-        // For predefined algorithms, determine width based on algorithm constant
-        is_32bit = (algorithm <= PHP_CRC_FAST_CRC32_XFER);
+        return custom_width == 32;
     }
 
-    if (binary) {
-        // For binary output, return the raw bytes
-        if (is_32bit) {
-            // 32-bit CRC
-            uint32_t result32 = (uint32_t)result;
-            result32 = htonl(result32);
-            RETURN_STRINGL((char*)&result32, sizeof(result32));
-        } else {
-            // 64-bit CRC
-            result = PHP_HTONLL(result);
-            RETURN_STRINGL((char*)&result, sizeof(result));
+    // For predefined algorithms, use the width from the descriptor table
+    const php_crc_fast_algorithm_info *info = php_crc_fast_find_algorithm(algorithm);
+    return info && info->width == 32;
+}
+
+/* Helper function to build the checksum output string in any of the string PHP_CRC_FAST_FORMAT_* formats */
+static inline zend_string *php_crc_fast_result_to_string(uint64_t result, bool is_32bit, zend_long format)
+{
+    static const char hexits[] = "0123456789abcdef";
+    static const char hexits_upper[] = "0123456789ABCDEF";
+    size_t size = is_32bit ? 4 : 8;
+    zend_string *str;
+
+    switch (format) {
+        case PHP_CRC_FAST_FORMAT_BINARY:
+        case PHP_CRC_FAST_FORMAT_BASE64: {
+            unsigned char bytes[8];
+            for (size_t i = 0; i < size; i++) {
+                bytes[i] = (unsigned char)(result >> (8 * (size - 1 - i)));
+            }
+
+            if (format == PHP_CRC_FAST_FORMAT_BASE64) {
+                return php_base64_encode(bytes, size);
+            }
+
+            return zend_string_init((const char*)bytes, size, 0);
         }
-    } else {
-        if (is_32bit) {
-            // 32-bit CRC
-            char checksum_str[9]; // 8 hex digits + null terminator
-            snprintf(checksum_str, sizeof(checksum_str), "%08x", (uint32_t)result);
-            RETURN_STRING(checksum_str);
-        } else {
-            // 64-bit CRC
-            char checksum_str[17]; // 16 hex digits + null terminator
-            snprintf(checksum_str, sizeof(checksum_str), "%016" PRIx64, result);
-            RETURN_STRING(checksum_str);
+
+        case PHP_CRC_FAST_FORMAT_BINARY_LE:
+            str = zend_string_alloc(size, 0);
+            for (size_t i = 0; i < size; i++) {
+                ZSTR_VAL(str)[i] = (char)(result >> (8 * i));
+            }
+            break;
+
+        default: {
+            const char *digits = (format == PHP_CRC_FAST_FORMAT_HEX_UPPER) ? hexits_upper : hexits;
+            size *= 2;
+            str = zend_string_alloc(size, 0);
+            for (size_t i = 0; i < size; i++) {
+                ZSTR_VAL(str)[i] = digits[(result >> (4 * (size - 1 - i))) & 0xF];
+            }
+            break;
         }
     }
+
+    ZSTR_VAL(str)[size] = '\0';
+
+    return str;
+}
+
+/* Helper function to return checksum output as an integer
+ *
+ * CRC-32 results are the checksum as-is, so always non-negative on 64-bit builds. CRC-64 results are the same 64 bits
+ * reinterpreted as a two's complement zend_long, so results with the top bit set are negative; sprintf('%016x') still
+ * gives the usual hex form. CRC-64 results don't fit in the zend_long of 32-bit builds, so they throw there.
+ */
+static inline void php_crc_fast_format_result_int(INTERNAL_FUNCTION_PARAMETERS, zend_long algorithm, uint64_t result, bool is_custom = false, uint8_t custom_width = 0)
+{
+#if SIZEOF_ZEND_LONG == 4
+    if (!php_crc_fast_is_32bit(algorithm, is_custom, custom_width)) {
+        zend_throw_exception(zend_ce_exception, "CRC-64 checksums cannot be returned as integers on 32-bit platforms", 0);
+        return;
+    }
+#endif
+
+    RETURN_LONG((zend_long)result);
+}
+
+/* Helper function to format checksum output, in any of the PHP_CRC_FAST_FORMAT_* formats
+ *
+ * A zend_bool $binary can be passed as the format, since false and true are PHP_CRC_FAST_FORMAT_HEX and _BINARY.
+ */
+static inline void php_crc_fast_format_result(INTERNAL_FUNCTION_PARAMETERS, zend_long algorithm, uint64_t result, zend_long format, bool is_custom = false, uint8_t custom_width = 0)
+{
+    if (format == PHP_CRC_FAST_FORMAT_INT) {
+        php_crc_fast_format_result_int(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, is_custom, custom_width);
+        return;
+    }
+
+    RETURN_NEW_STR(php_crc_fast_result_to_string(result, php_crc_fast_is_32bit(algorithm, is_custom, custom_width), format));
+}
+
+/* Helper function to store one of several checksums in a zval, in any of the PHP_CRC_FAST_FORMAT_* formats, after
+ * php_crc_fast_check_format() has been called once for all of them */
+static inline void php_crc_fast_result_to_zval(zval *out, uint64_t result, bool is_32bit, zend_long format)
+{
+    if (format == PHP_CRC_FAST_FORMAT_INT) {
+        ZVAL_LONG(out, (zend_long)result);
+    } else {
+        ZVAL_STR(out, php_crc_fast_result_to_string(result, is_32bit, format));
+    }
+}
+
+/* Helper function to check up front that checksums can be returned in format, for functions returning several */
+static inline bool php_crc_fast_check_format(zend_long format, bool is_32bit)
+{
+#if SIZEOF_ZEND_LONG == 4
+    if (format == PHP_CRC_FAST_FORMAT_INT && !is_32bit) {
+        zend_throw_exception(zend_ce_exception, "CRC-64 checksums cannot be returned as integers on 32-bit platforms", 0);
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+/* Helper function to pick the output format from the $binary and $format parameters, $format wins if given */
+static inline bool php_crc_fast_get_format(zend_bool binary, zend_long format, bool format_is_null, zend_long *format_out)
+{
+    if (format_is_null) {
+        *format_out = binary ? PHP_CRC_FAST_FORMAT_BINARY : PHP_CRC_FAST_FORMAT_HEX;
+        return true;
+    }
+
+    if (format < PHP_CRC_FAST_FORMAT_HEX || format > PHP_CRC_FAST_FORMAT_INT) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Invalid output format %lld. Use one of the CrcFast\\FORMAT_* constants", format);
+        return false;
+    }
+
+    *format_out = format;
+    return true;
+}
+
+/* Helper function to narrow data to the $offset and $length parameters, in place and without copying, throwing if
+ * the range doesn't fit inside it */
+static inline bool php_crc_fast_get_data_range(
+    char **data, size_t *data_len, zend_long offset, zend_long length, bool length_is_null)
+{
+    if (offset < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Offset must be non-negative, got %lld", offset);
+        return false;
+    }
+
+    if (!length_is_null && length < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Length must be non-negative, got %lld", length);
+        return false;
+    }
+
+    // A null length runs to the end of the data, anything else must fit inside it
+    size_t range_length = length_is_null ? *data_len - MIN((size_t)offset, *data_len) : (size_t)length;
+    if ((zend_ulong)offset > *data_len || range_length > *data_len - (size_t)offset) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Range of %zu bytes at offset %lld is beyond the end of the data (%zu bytes)",
+            range_length, offset, *data_len);
+        return false;
+    }
+
+    *data += offset;
+    *data_len = range_length;
+
+    return true;
 }
 
 /* Helper function to convert PHP algorithm int to FFICrcAlgorithm enum */
 static inline CrcFastAlgorithm php_crc_fast_get_algorithm(zend_long algo) {
-    switch (algo) {
-        case PHP_CRC_FAST_CRC32_AIXM:      return CrcFastAlgorithm::Crc32Aixm;
-        case PHP_CRC_FAST_CRC32_AUTOSAR:   return CrcFastAlgorithm::Crc32Autosar;
-        case PHP_CRC_FAST_CRC32_BASE91D:   return CrcFastAlgorithm::Crc32Base91D;
-        case PHP_CRC_FAST_CRC32_BZIP2:     return CrcFastAlgorithm::Crc32Bzip2;
-        case PHP_CRC_FAST_CRC32_CDROM_EDC: return CrcFastAlgorithm::Crc32CdRomEdc;
-        case PHP_CRC_FAST_CRC32_CKSUM:     return CrcFastAlgorithm::Crc32Cksum;
-        case PHP_CRC_FAST_CRC32_ISCSI:     return CrcFastAlgorithm::Crc32Iscsi;
-        case PHP_CRC_FAST_CRC32_ISO_HDLC:  return CrcFastAlgorithm::Crc32IsoHdlc;
-        case PHP_CRC_FAST_CRC32_JAMCRC:    return CrcFastAlgorithm::Crc32Jamcrc;
-        case PHP_CRC_FAST_CRC32_MEF:       return CrcFastAlgorithm::Crc32Mef;
-        case PHP_CRC_FAST_CRC32_MPEG2:     return CrcFastAlgorithm::Crc32Mpeg2;
-        case PHP_CRC_FAST_CRC32_XFER:      return CrcFastAlgorithm::Crc32Xfer;
-        case PHP_CRC_FAST_CRC64_ECMA182:   return CrcFastAlgorithm::Crc64Ecma182;
-        case PHP_CRC_FAST_CRC64_GO_ISO:    return CrcFastAlgorithm::Crc64GoIso;
-        case PHP_CRC_FAST_CRC64_MS:        return CrcFastAlgorithm::Crc64Ms;
-        case PHP_CRC_FAST_CRC64_NVME:      return CrcFastAlgorithm::Crc64Nvme;
-        case PHP_CRC_FAST_CRC64_REDIS:     return CrcFastAlgorithm::Crc64Redis;
-        case PHP_CRC_FAST_CRC64_WE:        return CrcFastAlgorithm::Crc64We;
-        case PHP_CRC_FAST_CRC64_XZ:        return CrcFastAlgorithm::Crc64Xz;
-
-        // this is a special flower, just to handle PHP's `hash('crc32')` operation,
-        // which is actually byte-reversed CRC-32/BZIP2
-        case PHP_CRC_FAST_CRC32_PHP:       return CrcFastAlgorithm::Crc32Bzip2;
-
-        default:
-            zend_throw_exception_ex(zend_ce_exception, 0,
-                "Invalid algorithm constant %lld. Use CrcFast\\get_supported_algorithms() to see valid values", algo);
-            return CrcFastAlgorithm::Crc32IsoHdlc; // Fallback (never reached due to exception)
+    const php_crc_fast_algorithm_info *info = php_crc_fast_find_algorithm(algo);
+    if (EXPECTED(info)) {
+        return info->algorithm;
     }
+
+    zend_throw_exception_ex(zend_ce_exception, 0,
+        "Invalid algorithm constant %lld. Use CrcFast\\get_supported_algorithms() to see valid values", algo);
+    return CrcFastAlgorithm::Crc32IsoHdlc; // Fallback (never reached due to exception)
 }
 
-/* Helper function to reverse bytes for CRC-32/PHP compatibility which matches PHP's `hash('crc32')` output */
+/* Helper function to reverse bytes for algorithms flagged reverse_bytes in php_crc_fast_algorithms, such as
+ * CRC-32/PHP which matches PHP's `hash('crc32')` output */
 static inline uint64_t php_crc_fast_reverse_bytes_if_needed(uint64_t result, zend_long algorithm)
 {
-    // Only reverse bytes for PHP_CRC_FAST_CRC32_PHP
-    if (algorithm == PHP_CRC_FAST_CRC32_PHP) {
+    const php_crc_fast_algorithm_info *info = php_crc_fast_find_algorithm(algorithm);
+
+    if (info && info->reverse_bytes) {
         // For CRC32, we only need to reverse the lower 32 bits
         uint32_t result32 = (uint32_t)result;
         result32 = ((result32 & 0xFF) << 24) |
@@ -227,11 +525,38 @@ static inline uint64_t php_crc_fast_reverse_bytes_if_needed(uint64_t result, zen
     return result;
 }
 
+/* Custom algorithms loaded from the crc_fast.custom_algorithms file at MINIT, read-only afterwards */
+static php_crc_fast_custom_algorithm *php_crc_fast_custom_algorithms = NULL;
+static uint32_t php_crc_fast_custom_algorithm_count = 0;
+
+/* Helper function to find a custom algorithm from the crc_fast.custom_algorithms file by its constant */
+static inline const php_crc_fast_custom_algorithm *php_crc_fast_get_custom_algorithm(zend_long algorithm)
+{
+    if (algorithm < PHP_CRC_FAST_CUSTOM_BASE || algorithm > PHP_CRC_FAST_CUSTOM_BASE + PHP_CRC_FAST_CUSTOM_MAX_ID) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < php_crc_fast_custom_algorithm_count; i++) {
+        if (php_crc_fast_custom_algorithms[i].id == algorithm) {
+            return &php_crc_fast_custom_algorithms[i];
+        }
+    }
+
+    return NULL;
+}
+
 /* Helper function to detect parameter type and extract CrcFastParams if needed */
 static inline bool php_crc_fast_get_params_from_zval(zval *algorithm_zval, zend_long *algorithm_out, CrcFastParams *params_out)
 {
     if (Z_TYPE_P(algorithm_zval) == IS_LONG) {
-        // It's an integer algorithm constant
+        // It's an integer algorithm constant, either built in or from the crc_fast.custom_algorithms file
+        const php_crc_fast_custom_algorithm *custom = php_crc_fast_get_custom_algorithm(Z_LVAL_P(algorithm_zval));
+        if (custom) {
+            *params_out = custom->params;
+            *algorithm_out = 0; // Not used for custom parameters
+            return true; // Custom parameters
+        }
+
         *algorithm_out = Z_LVAL_P(algorithm_zval);
         return false; // Not custom parameters
     } else if (Z_TYPE_P(algorithm_zval) == IS_OBJECT && 
@@ -254,51 +579,283 @@ static inline bool php_crc_fast_get_params_from_zval(zval *algorithm_zval, zend_
     }
 }
 
-/* {{{ CrcFast\crc32(string $data): int */
-PHP_FUNCTION(CrcFast_crc32)
+/* Runtime statistics, see crc_fast.stats
+ *
+ * Each thread (PHP's own, and our workers) claims a block of its own on its first recording, and counts into it with
+ * plain relaxed loads and stores, so recording never locks or contends. A thread gives its block back when it exits,
+ * counts and all, for the next new thread to carry on from, so get_stats() sums every thread the process has had just
+ * by summing the blocks. Threads that find every block claimed share one more, with atomic adds. reset_stats() only
+ * moves the baseline that get_stats() subtracts, which never races with a thread's own writes. Both sum the blocks
+ * under php_crc_fast_stats_mutex, so a baseline is never taken after the sum it's subtracted from.
+ *
+ * The blocks are a static array of plain atomics, with nothing to construct or destroy, so a worker thread that
+ * exits after MSHUTDOWN, or while static objects are being destroyed, only touches memory that's still there. */
+enum php_crc_fast_stats_entry {
+    PHP_CRC_FAST_STATS_CRC32,        // CrcFast\crc32()
+    PHP_CRC_FAST_STATS_HASH,         // CrcFast\hash(), CrcFast\hash_int()
+    PHP_CRC_FAST_STATS_HASH_MANY,    // CrcFast\hash_many(), one call per item
+    PHP_CRC_FAST_STATS_HASH_CHUNKS,  // CrcFast\hash_chunks()
+    PHP_CRC_FAST_STATS_HASH_MULTI,   // CrcFast\hash_multi(), CrcFast\MultiDigest::update(), one call per algorithm
+    PHP_CRC_FAST_STATS_HASH_FILE,    // CrcFast\hash_file(), hash_file_range(), hash_file_parallel(), hash_file_chunks()
+    PHP_CRC_FAST_STATS_HASH_FILES,   // CrcFast\hash_files(), one call per file, recorded by the worker threads
+    PHP_CRC_FAST_STATS_HASH_ASYNC,   // CrcFast\hash_file_async(), recorded by the worker thread
+    PHP_CRC_FAST_STATS_VERIFY,       // CrcFast\verify(), CrcFast\verify_many()
+    PHP_CRC_FAST_STATS_DIGEST,       // CrcFast\Digest::update(), CrcFast\Digest::updateStream()
+    PHP_CRC_FAST_STATS_EXT_HASH,     // ext/hash backends, one call per update
+    PHP_CRC_FAST_STATS_FILTER,       // "crcfast.*" stream filters
+    PHP_CRC_FAST_STATS_ENTRY_COUNT
+};
+
+static const char *php_crc_fast_stats_entry_names[PHP_CRC_FAST_STATS_ENTRY_COUNT] = {
+    "crc32",
+    "hash",
+    "hash_many",
+    "hash_chunks",
+    "hash_multi",
+    "hash_file",
+    "hash_files",
+    "hash_file_async",
+    "verify",
+    "digest",
+    "ext_hash",
+    "filter",
+};
+
+// CrcFast\Params and the crc_fast.custom_algorithms file all share the last slot
+#define PHP_CRC_FAST_STATS_CUSTOM PHP_CRC_FAST_ALGORITHM_COUNT
+#define PHP_CRC_FAST_STATS_ALGORITHM_COUNT (PHP_CRC_FAST_STATS_CUSTOM + 1)
+
+typedef struct _php_crc_fast_stats_counter {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> ns{0};
+} php_crc_fast_stats_counter;
+
+/* One thread's counters, only ever written by the thread that has claimed it */
+typedef struct _php_crc_fast_stats_block {
+    std::atomic<bool> claimed{false};
+    php_crc_fast_stats_counter counters[PHP_CRC_FAST_STATS_ALGORITHM_COUNT][PHP_CRC_FAST_STATS_ENTRY_COUNT];
+    std::atomic<uint64_t> histogram[PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS];
+} php_crc_fast_stats_block;
+
+/* A point in time sum of blocks */
+typedef struct _php_crc_fast_stats_totals {
+    uint64_t counters[PHP_CRC_FAST_STATS_ALGORITHM_COUNT][PHP_CRC_FAST_STATS_ENTRY_COUNT][3];  // calls, bytes, ns
+    uint64_t histogram[PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS];
+} php_crc_fast_stats_totals;
+
+/* Set from crc_fast.stats and crc_fast.stats_timing at MINIT, read-only afterwards */
+static bool php_crc_fast_stats_enabled = false;
+static bool php_crc_fast_stats_timing = false;
+
+static php_crc_fast_stats_block php_crc_fast_stats_blocks[PHP_CRC_FAST_STATS_MAX_BLOCKS];
+static php_crc_fast_stats_block php_crc_fast_stats_shared;  // For threads that find every block claimed
+
+static std::mutex php_crc_fast_stats_mutex;  // Guards the baseline, only ever locked by request threads
+static php_crc_fast_stats_totals php_crc_fast_stats_baseline;  // Everything as of the last reset_stats()
+
+static void php_crc_fast_stats_add(php_crc_fast_stats_totals *totals, const php_crc_fast_stats_block *block)
 {
-    char *data;
-    size_t data_len;
+    for (size_t a = 0; a < PHP_CRC_FAST_STATS_ALGORITHM_COUNT; a++) {
+        for (size_t e = 0; e < PHP_CRC_FAST_STATS_ENTRY_COUNT; e++) {
+            const php_crc_fast_stats_counter &counter = block->counters[a][e];
+            totals->counters[a][e][0] += counter.calls.load(std::memory_order_relaxed);
+            totals->counters[a][e][1] += counter.bytes.load(std::memory_order_relaxed);
+            totals->counters[a][e][2] += counter.ns.load(std::memory_order_relaxed);
+        }
+    }
 
-    ZEND_PARSE_PARAMETERS_START(1, 1)
-        Z_PARAM_STRING(data, data_len)
-    ZEND_PARSE_PARAMETERS_END();
+    for (size_t b = 0; b < PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS; b++) {
+        totals->histogram[b] += block->histogram[b].load(std::memory_order_relaxed);
+    }
+}
+
+/* Helper function to sum every block, shared or not */
+static void php_crc_fast_stats_add_all(php_crc_fast_stats_totals *totals)
+{
+    for (size_t i = 0; i < PHP_CRC_FAST_STATS_MAX_BLOCKS; i++) {
+        php_crc_fast_stats_add(totals, &php_crc_fast_stats_blocks[i]);
+    }
+    php_crc_fast_stats_add(totals, &php_crc_fast_stats_shared);
+}
+
+/* Holds the calling thread's claimed block, and gives it back when the thread exits */
+struct php_crc_fast_stats_thread {
+    php_crc_fast_stats_block *block = NULL;
+
+    ~php_crc_fast_stats_thread() {
+        // Release, so the next thread to claim it carries on from these counts
+        if (block && block != &php_crc_fast_stats_shared) {
+            block->claimed.store(false, std::memory_order_release);
+        }
+    }
+};
+
+static thread_local php_crc_fast_stats_thread php_crc_fast_stats_local;
+
+static inline uint64_t php_crc_fast_stats_now(void)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Helper function to start timing a call, 0 unless crc_fast.stats_timing is on */
+static inline uint64_t php_crc_fast_stats_start(void)
+{
+    return UNEXPECTED(php_crc_fast_stats_timing) ? php_crc_fast_stats_now() : 0;
+}
+
+/* Only the owning thread writes its counters, so there's no need for an atomic read-modify-write, except in the
+ * shared block */
+static inline void php_crc_fast_stats_bump(std::atomic<uint64_t> &counter, uint64_t value, bool shared)
+{
+    if (UNEXPECTED(shared)) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    } else {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+/* Helper function to claim a block for the calling thread on its first recording, or the shared one if there are
+ * none left */
+static php_crc_fast_stats_block *php_crc_fast_stats_claim(void)
+{
+    for (size_t i = 0; i < PHP_CRC_FAST_STATS_MAX_BLOCKS; i++) {
+        bool claimed = false;
+        // Acquire, to carry on from the counts of whichever thread had it last
+        if (!php_crc_fast_stats_blocks[i].claimed.load(std::memory_order_relaxed)
+            && php_crc_fast_stats_blocks[i].claimed.compare_exchange_strong(claimed, true, std::memory_order_acquire)) {
+            return &php_crc_fast_stats_blocks[i];
+        }
+    }
+
+    return &php_crc_fast_stats_shared;
+}
 
+static inline size_t php_crc_fast_stats_bucket(uint64_t bytes)
+{
+    if (bytes == 0) {
+        return 0;
+    }
+
+#if defined(__GNUC__)
+    size_t bucket = 64 - (size_t)__builtin_clzll(bytes);
+#else
+    size_t bucket = 0;
+    for (uint64_t remaining = bytes; remaining; remaining >>= 1) {
+        bucket++;
+    }
+#endif
+
+    return MIN(bucket, (size_t)PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS - 1);
+}
+
+static void php_crc_fast_stats_record_ns(
+    php_crc_fast_stats_entry entry, zend_long algorithm, bool is_custom, uint64_t bytes, uint64_t ns)
+{
+    php_crc_fast_stats_block *block = php_crc_fast_stats_local.block;
+    if (UNEXPECTED(!block)) {
+        block = php_crc_fast_stats_claim();
+        php_crc_fast_stats_local.block = block;
+    }
+    bool shared = block == &php_crc_fast_stats_shared;
+
+    size_t index = PHP_CRC_FAST_STATS_CUSTOM;
+    if (!is_custom) {
+        const php_crc_fast_algorithm_info *info = php_crc_fast_find_algorithm(algorithm);
+        if (info) {
+            index = info - php_crc_fast_algorithms;
+        }
+    }
+
+    php_crc_fast_stats_counter &counter = block->counters[index][entry];
+    php_crc_fast_stats_bump(counter.calls, 1, shared);
+    php_crc_fast_stats_bump(counter.bytes, bytes, shared);
+    php_crc_fast_stats_bump(counter.ns, ns, shared);
+    php_crc_fast_stats_bump(block->histogram[php_crc_fast_stats_bucket(bytes)], 1, shared);
+}
+
+/* Helper function to record one call of bytes, timed from php_crc_fast_stats_start(). Safe on any thread, and
+ * free apart from a branch when crc_fast.stats is off. */
+static inline void php_crc_fast_stats_record(
+    php_crc_fast_stats_entry entry, zend_long algorithm, bool is_custom, uint64_t bytes, uint64_t start)
+{
+    if (UNEXPECTED(php_crc_fast_stats_enabled)) {
+        php_crc_fast_stats_record_ns(entry, algorithm, is_custom, bytes, start ? php_crc_fast_stats_now() - start : 0);
+    }
+}
+
+/* Helper function to sum every thread's counters since the last reset_stats()
+ *
+ * The sum is taken with the mutex held, as reset_stats() takes its baseline, so the baseline is never newer than the
+ * sum and the subtraction can't wrap. */
+static void php_crc_fast_stats_collect(php_crc_fast_stats_totals *totals)
+{
+    std::lock_guard<std::mutex> lock(php_crc_fast_stats_mutex);
+
+    *totals = {};
+    php_crc_fast_stats_add_all(totals);
+
+    for (size_t a = 0; a < PHP_CRC_FAST_STATS_ALGORITHM_COUNT; a++) {
+        for (size_t e = 0; e < PHP_CRC_FAST_STATS_ENTRY_COUNT; e++) {
+            for (size_t c = 0; c < 3; c++) {
+                totals->counters[a][e][c] -= php_crc_fast_stats_baseline.counters[a][e][c];
+            }
+        }
+    }
+
+    for (size_t b = 0; b < PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS; b++) {
+        totals->histogram[b] -= php_crc_fast_stats_baseline.histogram[b];
+    }
+}
+
+/* Helper function for the body of CrcFast\crc32(), shared with its frameless variant */
+static zend_always_inline zend_long php_crc_fast_crc32_data(const char *data, size_t data_len)
+{
+    uint64_t stats_start = php_crc_fast_stats_start();
     uint64_t result = crc_fast_checksum(CrcFastAlgorithm::Crc32IsoHdlc, data, data_len);
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_CRC32, PHP_CRC_FAST_CRC32_ISO_HDLC, false, data_len, stats_start);
 
-    // Return as integer
-    RETURN_LONG((zend_long)result);
+    return (zend_long)result;
 }
-/* }}} */
 
-/* {{{ CrcFast\hash(int|CrcFast\Params $algorithm, string $data, bool $binary = false): string */
-PHP_FUNCTION(CrcFast_hash)
+/* {{{ CrcFast\crc32(string $data): int */
+PHP_FUNCTION(CrcFast_crc32)
 {
-    zval *algorithm_zval;
     char *data;
     size_t data_len;
-    zend_bool binary = 0;
 
-    ZEND_PARSE_PARAMETERS_START(3, 3)
-        Z_PARAM_ZVAL(algorithm_zval)
+    ZEND_PARSE_PARAMETERS_START(1, 1)
         Z_PARAM_STRING(data, data_len)
-        Z_PARAM_BOOL(binary)
     ZEND_PARSE_PARAMETERS_END();
 
-    // Validate data parameter
-    if (!data) {
-        zend_throw_exception(zend_ce_exception, "Data parameter cannot be null", 0);
-        return;
-    }
+    // Return as integer
+    RETURN_LONG(php_crc_fast_crc32_data(data, data_len));
+}
+/* }}} */
 
+/* Helper function for the body of CrcFast\hash() once its parameters are parsed, shared with its frameless
+ * variants. Those run without a frame of their own, so execute_data is NULL there and must only be passed along. */
+static zend_always_inline void php_crc_fast_hash_data(
+    INTERNAL_FUNCTION_PARAMETERS, zval *algorithm_zval, const char *data, size_t data_len, zend_long output_format)
+{
     zend_long algorithm;
     CrcFastParams custom_params;
-    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
-    
-    if (EG(exception)) {
-        return; // Exception was thrown by helper function
+    bool is_custom;
+
+    if (EXPECTED(Z_TYPE_P(algorithm_zval) == IS_LONG && Z_LVAL_P(algorithm_zval) < PHP_CRC_FAST_CUSTOM_BASE)) {
+        // Built-in constants, by far the most common, can't be custom so skip looking for parameters
+        algorithm = Z_LVAL_P(algorithm_zval);
+        is_custom = false;
+    } else {
+        is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+
+        if (EG(exception)) {
+            return; // Exception was thrown by helper function
+        }
     }
 
+    uint64_t stats_start = php_crc_fast_stats_start();
     uint64_t result;
     if (is_custom) {
         // Use custom parameters - handle potential C library errors
@@ -308,7 +865,8 @@ PHP_FUNCTION(CrcFast_hash)
             zend_throw_exception(zend_ce_exception, "Failed to compute CRC checksum with custom parameters", 0);
             return;
         }
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, binary, true, custom_params.width);
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH, 0, true, data_len, stats_start);
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, output_format, true, custom_params.width);
     } else {
         // Use predefined algorithm - handle potential C library errors
         CrcFastAlgorithm algo = php_crc_fast_get_algorithm(algorithm);
@@ -323,141 +881,388 @@ PHP_FUNCTION(CrcFast_hash)
                 "Failed to compute CRC checksum for algorithm %lld", algorithm);
             return;
         }
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH, algorithm, false, data_len, stats_start);
 
         // Apply byte reversal if needed
         result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
 
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, binary);
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, output_format);
     }
 }
-/* }}} */
 
-/* {{{ CrcFast\hash_file(int|CrcFast\Params $algorithm, string $filename, bool $binary = false, ?int $chunk_size = null): string */
-PHP_FUNCTION(CrcFast_hash_file)
+/* {{{ CrcFast\hash(int|CrcFast\Params $algorithm, string $data, bool $binary = false, ?int $format = null, int $offset = 0, ?int $length = null): string|int */
+PHP_FUNCTION(CrcFast_hash)
 {
     zval *algorithm_zval;
-    char *filename;
-    size_t filename_len;
+    char *data;
+    size_t data_len;
     zend_bool binary = 0;
-    zval *chunk_size_zval = NULL;
+    zend_long format = 0;
+    bool format_is_null = 1;
+    zend_long offset = 0;
+    zend_long length = 0;
+    bool length_is_null = 1;
 
-    ZEND_PARSE_PARAMETERS_START(3, 4)
+    ZEND_PARSE_PARAMETERS_START(2, 6)
         Z_PARAM_ZVAL(algorithm_zval)
-        Z_PARAM_STRING(filename, filename_len)
-        Z_PARAM_BOOL(binary)
+        Z_PARAM_STRING(data, data_len)
         Z_PARAM_OPTIONAL
-        Z_PARAM_ZVAL_OR_NULL(chunk_size_zval)
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+        Z_PARAM_LONG(offset)
+        Z_PARAM_LONG_OR_NULL(length, length_is_null)
     ZEND_PARSE_PARAMETERS_END();
 
-    // Validate filename parameter
-    if (!filename || filename_len == 0) {
-        zend_throw_exception(zend_ce_exception, "Filename cannot be empty", 0);
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
         return;
     }
 
-    // Check if file exists and is readable
-    if (php_check_open_basedir(filename)) {
-        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not within the allowed path(s)", filename);
+    // Validate data parameter
+    if (!data) {
+        zend_throw_exception(zend_ce_exception, "Data parameter cannot be null", 0);
+        return;
+    }
+
+    if (!php_crc_fast_get_data_range(&data, &data_len, offset, length, length_is_null)) {
         return;
     }
 
+    php_crc_fast_hash_data(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm_zval, data, data_len, output_format);
+}
+/* }}} */
+
+#if PHP_VERSION_ID >= 80400
+/* Frameless variants of CrcFast\crc32() and CrcFast\hash(), which PHP 8.4+ calls directly from the VM for fully
+ * qualified (or imported) calls with exactly this many arguments, skipping the call frame and ZPP. The arguments
+ * are already dereferenced, but still need the usual coercion and type errors, which the Z_FLF_PARAM_* macros do. */
+
+/* {{{ CrcFast\crc32(string $data): int */
+ZEND_FRAMELESS_FUNCTION(CrcFast_crc32, 1)
+{
+    zval data_tmp;
+    zend_string *data;
+
+    Z_FLF_PARAM_STR(1, data, data_tmp);
+
+    RETVAL_LONG(php_crc_fast_crc32_data(ZSTR_VAL(data), ZSTR_LEN(data)));
+
+flf_clean:
+    Z_FLF_PARAM_FREE_STR(1, data_tmp);
+}
+/* }}} */
+
+/* {{{ CrcFast\hash(int|CrcFast\Params $algorithm, string $data): string */
+ZEND_FRAMELESS_FUNCTION(CrcFast_hash, 2)
+{
+    zval *algorithm_zval;
+    zval data_tmp;
+    zend_string *data;
+
+    Z_FLF_PARAM_ZVAL(1, algorithm_zval);
+    Z_FLF_PARAM_STR(2, data, data_tmp);
+
+    php_crc_fast_hash_data(NULL, return_value, algorithm_zval, ZSTR_VAL(data), ZSTR_LEN(data), PHP_CRC_FAST_FORMAT_HEX);
+
+flf_clean:
+    Z_FLF_PARAM_FREE_STR(2, data_tmp);
+}
+/* }}} */
+
+/* {{{ CrcFast\hash(int|CrcFast\Params $algorithm, string $data, bool $binary): string */
+ZEND_FRAMELESS_FUNCTION(CrcFast_hash, 3)
+{
+    zval *algorithm_zval;
+    zval data_tmp;
+    zend_string *data;
+    bool binary;
+
+    Z_FLF_PARAM_ZVAL(1, algorithm_zval);
+    Z_FLF_PARAM_STR(2, data, data_tmp);
+    Z_FLF_PARAM_BOOL(3, binary);
+
+    php_crc_fast_hash_data(NULL, return_value, algorithm_zval, ZSTR_VAL(data), ZSTR_LEN(data),
+        binary ? PHP_CRC_FAST_FORMAT_BINARY : PHP_CRC_FAST_FORMAT_HEX);
+
+flf_clean:
+    Z_FLF_PARAM_FREE_STR(2, data_tmp);
+}
+/* }}} */
+#endif
+
+/* {{{ CrcFast\hash_int(int|CrcFast\Params $algorithm, string $data): int */
+PHP_FUNCTION(CrcFast_hash_int)
+{
+    zval *algorithm_zval;
+    char *data;
+    size_t data_len;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_STRING(data, data_len)
+    ZEND_PARSE_PARAMETERS_END();
+
     zend_long algorithm;
     CrcFastParams custom_params;
     bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
-    
+
     if (EG(exception)) {
         return; // Exception was thrown by helper function
     }
 
+    uint64_t stats_start = php_crc_fast_stats_start();
     uint64_t result;
     if (is_custom) {
-        // Use custom parameters - handle potential C library errors
         try {
-            result = crc_fast_checksum_file_with_params(custom_params, (const uint8_t*)filename, filename_len);
+            result = crc_fast_checksum_with_params(custom_params, data, data_len);
         } catch (...) {
-            zend_throw_exception_ex(zend_ce_exception, 0, 
-                "Failed to compute CRC checksum for file '%s' with custom parameters", filename);
+            zend_throw_exception(zend_ce_exception, "Failed to compute CRC checksum with custom parameters", 0);
             return;
         }
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, binary, true, custom_params.width);
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH, 0, true, data_len, stats_start);
+        php_crc_fast_format_result_int(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, true, custom_params.width);
     } else {
-        // Use predefined algorithm - handle potential C library errors
         CrcFastAlgorithm algo = php_crc_fast_get_algorithm(algorithm);
         if (EG(exception)) {
             return; // Exception was thrown by get_algorithm
         }
-        
+
         try {
-            result = crc_fast_checksum_file(algo, (const uint8_t*)filename, filename_len);
+            result = crc_fast_checksum(algo, data, data_len);
         } catch (...) {
-            zend_throw_exception_ex(zend_ce_exception, 0, 
-                "Failed to compute CRC checksum for file '%s' with algorithm %lld", filename, algorithm);
+            zend_throw_exception_ex(zend_ce_exception, 0,
+                "Failed to compute CRC checksum for algorithm %lld", algorithm);
             return;
         }
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH, algorithm, false, data_len, stats_start);
 
-        // Apply byte reversal if needed
+        // Apply byte reversal if needed, so the integer matches the hex output
         result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
 
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, binary);
+        php_crc_fast_format_result_int(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result);
     }
 }
 /* }}} */
 
-/* {{{ CrcFast\get_supported_algorithms(): array */
-PHP_FUNCTION(CrcFast_get_supported_algorithms)
+/* {{{ CrcFast\hash_many(int|CrcFast\Params $algorithm, array $data, bool $binary = false, ?int $format = null): array */
+PHP_FUNCTION(CrcFast_hash_many)
 {
-    ZEND_PARSE_PARAMETERS_NONE();
+    zval *algorithm_zval;
+    HashTable *data;
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
 
-    array_init(return_value);
+    ZEND_PARSE_PARAMETERS_START(2, 4)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_ARRAY_HT(data)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    // Resolve everything once, up front, rather than per item
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    bool is_32bit = php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0);
+    if (!php_crc_fast_check_format(output_format, is_32bit)) {
+        return;
+    }
+
+    array_init_size(return_value, zend_hash_num_elements(data));
+
+    zend_ulong index;
+    zend_string *key;
+    zval *item;
+    ZEND_HASH_FOREACH_KEY_VAL(data, index, key, item) {
+        ZVAL_DEREF(item);
+        if (Z_TYPE_P(item) != IS_STRING) {
+            zval_ptr_dtor(return_value);
+            ZVAL_NULL(return_value);
+            if (key) {
+                zend_throw_exception_ex(zend_ce_exception, 0,
+                    "All data elements must be strings, element \"%s\" is %s", ZSTR_VAL(key), zend_zval_type_name(item));
+            } else {
+                zend_throw_exception_ex(zend_ce_exception, 0,
+                    "All data elements must be strings, element " ZEND_ULONG_FMT " is %s", index, zend_zval_type_name(item));
+            }
+            return;
+        }
+
+        uint64_t stats_start = php_crc_fast_stats_start();
+        uint64_t result;
+        if (is_custom) {
+            result = crc_fast_checksum_with_params(custom_params, Z_STRVAL_P(item), Z_STRLEN_P(item));
+        } else {
+            result = php_crc_fast_reverse_bytes_if_needed(
+                crc_fast_checksum(algo, Z_STRVAL_P(item), Z_STRLEN_P(item)), algorithm);
+        }
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_MANY, algorithm, is_custom, Z_STRLEN_P(item), stats_start);
+
+        zval checksum;
+        php_crc_fast_result_to_zval(&checksum, result, is_32bit, output_format);
 
-    add_assoc_long(return_value, "CRC-32/AIXM", PHP_CRC_FAST_CRC32_AIXM);
-    add_assoc_long(return_value, "CRC32_AUTOSAR", PHP_CRC_FAST_CRC32_AUTOSAR);
-    add_assoc_long(return_value, "CRC-32/BASE-91-D", PHP_CRC_FAST_CRC32_BASE91D);
-    add_assoc_long(return_value, "CRC-32/BZIP2", PHP_CRC_FAST_CRC32_BZIP2);
-    add_assoc_long(return_value, "CRC-32/CD-ROM-EDC", PHP_CRC_FAST_CRC32_CDROM_EDC);
-    add_assoc_long(return_value, "CRC-32/CKSUM", PHP_CRC_FAST_CRC32_CKSUM);
-    add_assoc_long(return_value, "CRC-32/ISCSI", PHP_CRC_FAST_CRC32_ISCSI);
-    add_assoc_long(return_value, "CRC-32/ISO_HDLC", PHP_CRC_FAST_CRC32_ISO_HDLC);
-    add_assoc_long(return_value, "CRC-32/JAMCRC", PHP_CRC_FAST_CRC32_JAMCRC);
-    add_assoc_long(return_value, "CRC-32/MEF", PHP_CRC_FAST_CRC32_MEF);
-    add_assoc_long(return_value, "CRC-32/MPEG-2", PHP_CRC_FAST_CRC32_MPEG2);
-    add_assoc_long(return_value, "CRC-32/XFER", PHP_CRC_FAST_CRC32_XFER);
-    add_assoc_long(return_value, "CRC-64/ECMA-182", PHP_CRC_FAST_CRC64_ECMA182);
-    add_assoc_long(return_value, "CRC-64/GO-ISO", PHP_CRC_FAST_CRC64_GO_ISO);
-    add_assoc_long(return_value, "CRC-64/MS", PHP_CRC_FAST_CRC64_MS);
-    add_assoc_long(return_value, "CRC-64/NVME", PHP_CRC_FAST_CRC64_NVME);
-    add_assoc_long(return_value, "CRC-64/REDIS", PHP_CRC_FAST_CRC64_REDIS);
-    add_assoc_long(return_value, "CRC-64/WE", PHP_CRC_FAST_CRC64_WE);
-    add_assoc_long(return_value, "CRC-64/XZ", PHP_CRC_FAST_CRC64_XZ);
+        // Preserve the input keys
+        if (key) {
+            zend_hash_update(Z_ARRVAL_P(return_value), key, &checksum);
+        } else {
+            zend_hash_index_update(Z_ARRVAL_P(return_value), index, &checksum);
+        }
+    } ZEND_HASH_FOREACH_END();
 }
 /* }}} */
 
-/* {{{ CrcFast\combine(int|CrcFast\Params $algorithm, string $checksum1, string $checksum2, int $length2, bool $binary = false): string */
-PHP_FUNCTION(CrcFast_combine)
+/* Helper function to feed up to max_length bytes of a stream into a digest, chunk_size bytes at a time through a
+ * reused buffer. The buffer never grows past PHP_CRC_FAST_MAX_STREAM_BUFFER, so a huge chunk_size just means reads
+ * of that size instead. Stops early at EOF, and returns false on read errors. */
+static bool php_crc_fast_digest_update_from_stream(
+    CrcFastDigestHandle *digest,
+    php_stream *stream,
+    size_t chunk_size,
+    size_t max_length,
+    size_t *consumed_out)
+{
+    size_t buf_size = MIN(MIN(chunk_size, max_length), (size_t)PHP_CRC_FAST_MAX_STREAM_BUFFER);
+    char *buf = (char*)emalloc(MAX(buf_size, 1));
+    size_t consumed = 0;
+    ssize_t read = 0;
+
+    while (consumed < max_length) {
+        read = php_stream_read(stream, buf, MIN(buf_size, max_length - consumed));
+        if (read <= 0) {
+            break;
+        }
+
+        crc_fast_digest_update(digest, buf, (size_t)read);
+        consumed += (size_t)read;
+    }
+
+    efree(buf);
+
+    if (consumed_out) {
+        *consumed_out = consumed;
+    }
+
+    return read >= 0;
+}
+
+/* Outcome of the CrcFast\hash_file() $io_mode helpers, so a failed read can be told apart from a failed allocation */
+enum php_crc_fast_io_status {
+    PHP_CRC_FAST_IO_STATUS_OK,
+    PHP_CRC_FAST_IO_STATUS_READ_FAILED,
+    PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED,
+};
+
+/* Used by CrcFast\hash_file() for its $io_mode, defined with the other native file hashing helpers below */
+static php_crc_fast_io_status php_crc_fast_checksum_fd_io(
+    int fd,
+    uint64_t length,
+    zend_long io_mode,
+    bool direct,
+    size_t chunk_size,
+    size_t queue_depth,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out);
+
+/* {{{ CrcFast\hash_file(int|CrcFast\Params $algorithm, string $filename, bool $binary = false, ?int $chunk_size = null, ?int $format = null, ?int $io_mode = null, ?int $queue_depth = null): string|int */
+PHP_FUNCTION(CrcFast_hash_file)
 {
     zval *algorithm_zval;
-    char *checksum1, *checksum2;
-    size_t checksum1_len, checksum2_len;
-    zend_long length2;
+    char *filename;
+    size_t filename_len;
     zend_bool binary = 0;
-
-    ZEND_PARSE_PARAMETERS_START(5, 5)
+    zend_long chunk_size = 0;
+    bool chunk_size_is_null = 1;
+    zend_long format = 0;
+    bool format_is_null = 1;
+    zend_long io_mode = PHP_CRC_FAST_IO_DEFAULT;
+    bool io_mode_is_null = 1;
+    zend_long queue_depth = PHP_CRC_FAST_DEFAULT_QUEUE_DEPTH;
+    bool queue_depth_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(2, 7)
         Z_PARAM_ZVAL(algorithm_zval)
-        Z_PARAM_STRING(checksum1, checksum1_len)
-        Z_PARAM_STRING(checksum2, checksum2_len)
-        Z_PARAM_LONG(length2)
+        Z_PARAM_STRING(filename, filename_len)
+        Z_PARAM_OPTIONAL
         Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(chunk_size, chunk_size_is_null)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+        Z_PARAM_LONG_OR_NULL(io_mode, io_mode_is_null)
+        Z_PARAM_LONG_OR_NULL(queue_depth, queue_depth_is_null)
     ZEND_PARSE_PARAMETERS_END();
 
-    // Validate parameters
-    if (!checksum1 || !checksum2) {
-        zend_throw_exception(zend_ce_exception, "Checksum parameters cannot be null", 0);
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
         return;
     }
 
-    if (length2 < 0) {
-        zend_throw_exception_ex(zend_ce_exception, 0, 
-            "Length parameter must be non-negative, got %lld", length2);
+    // Validate filename parameter
+    if (!filename || filename_len == 0) {
+        zend_throw_exception(zend_ce_exception, "Filename cannot be empty", 0);
+        return;
+    }
+
+    if (!chunk_size_is_null && chunk_size <= 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Chunk size must be positive, got %lld", chunk_size);
+        return;
+    }
+
+    if (io_mode_is_null) {
+        io_mode = PHP_CRC_FAST_IO_DEFAULT;
+    } else if (io_mode < PHP_CRC_FAST_IO_DEFAULT || io_mode > PHP_CRC_FAST_IO_URING) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Invalid I/O mode %lld. Use one of the CrcFast\\IO_* constants", io_mode);
+        return;
+    }
+
+#ifdef PHP_WIN32
+    if (io_mode == PHP_CRC_FAST_IO_MMAP || io_mode == PHP_CRC_FAST_IO_DIRECT) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "I/O mode %lld is not supported on Windows", io_mode);
+        return;
+    }
+#endif
+
+#ifndef HAVE_CRC_FAST_IO_URING
+    if (io_mode == PHP_CRC_FAST_IO_URING) {
+        zend_throw_exception(zend_ce_exception, "CrcFast\\IO_URING is not supported, the extension was built without liburing", 0);
+        return;
+    }
+#endif
+
+    if (!queue_depth_is_null && (queue_depth < 1 || queue_depth > PHP_CRC_FAST_MAX_QUEUE_DEPTH)) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Queue depth must be between 1 and %d, got %lld", PHP_CRC_FAST_MAX_QUEUE_DEPTH, queue_depth);
+        return;
+    }
+
+    // These allocate chunk_size up front (times the queue depth for IO_URING), unlike the stream wrappers, whose
+    // buffer is capped anyway, and IO_MMAP, which doesn't read in chunks
+    if (!chunk_size_is_null && chunk_size > PHP_CRC_FAST_MAX_CHUNK_SIZE
+        && io_mode != PHP_CRC_FAST_IO_DEFAULT && io_mode != PHP_CRC_FAST_IO_MMAP) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Chunk size must be no larger than %d bytes for this I/O mode, got %lld", PHP_CRC_FAST_MAX_CHUNK_SIZE, chunk_size);
         return;
     }
 
@@ -469,320 +1274,3492 @@ PHP_FUNCTION(CrcFast_combine)
         return; // Exception was thrown by helper function
     }
 
-    uint64_t cs1 = 0, cs2 = 0;
-
-    // Determine if we're dealing with 32-bit or 64-bit CRC
-    bool is_crc32;
-    if (is_custom) {
-        is_crc32 = (custom_params.width == 32);
-    } else {
-        is_crc32 = (algorithm <= PHP_CRC_FAST_CRC32_XFER);
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
     }
-    size_t expected_binary_size = is_crc32 ? 4 : 8;  // 4 bytes for CRC32, 8 bytes for CRC64
-    size_t expected_hex_size = is_crc32 ? 8 : 16;    // 8 hex chars for CRC32, 16 for CRC64
 
-    // Process checksum1
-    if (checksum1_len == expected_binary_size) {
-        // Binary input
-        if (is_crc32) {
-            cs1 = ntohl(*((uint32_t*)checksum1));
-        } else {
-            cs1 = PHP_NTOHLL(*((uint64_t*)checksum1));
+    // Plain files without an explicit chunk size go straight to the library, everything else is read
+    // through PHP's stream wrappers (phar://, compress.zlib://, php://, user wrappers, etc)
+    const char *path = filename;
+    php_stream_wrapper *wrapper = php_stream_locate_url_wrapper(filename, &path, 0);
+
+    uint64_t stats_start = php_crc_fast_stats_start();
+    uint64_t stats_bytes = 0;
+    uint64_t result;
+    if (io_mode != PHP_CRC_FAST_IO_DEFAULT) {
+        // The other modes read the file descriptor themselves, so this only works on plain files
+        if (wrapper != &php_plain_files_wrapper) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not a plain file", filename);
+            return;
         }
-    } else if (checksum1_len == expected_hex_size) {
-        // Hex input
-        if (is_crc32) {
-            uint32_t value = 0;
-            if (sscanf(checksum1, "%8x", &value) == 1) {
-                cs1 = value;
-            } else {
-                php_error_docref(NULL, E_WARNING, "Invalid hexadecimal input for checksum1");
-                RETURN_FALSE;
-            }
-        } else {
-            // For 64-bit values, we need to parse it manually because sscanf might not
-            // handle uint64_t correctly on all platforms
-            cs1 = 0;
-            for (size_t i = 0; i < 16; i++) {
-                char c = checksum1[i];
-                uint64_t digit;
 
-                if (c >= '0' && c <= '9') {
-                    digit = c - '0';
-                } else if (c >= 'a' && c <= 'f') {
-                    digit = c - 'a' + 10;
-                } else if (c >= 'A' && c <= 'F') {
-                    digit = c - 'A' + 10;
-                } else {
-                    php_error_docref(NULL, E_WARNING, "Invalid hexadecimal character in checksum1");
-                    RETURN_FALSE;
-                }
+        // Check if file exists and is readable
+        if (php_check_open_basedir(path)) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not within the allowed path(s)", filename);
+            return;
+        }
 
-                cs1 = (cs1 << 4) | digit;
-            }
+        int fd = -1;
+        bool direct = false;
+#if defined(O_DIRECT)
+        if (io_mode == PHP_CRC_FAST_IO_DIRECT) {
+            // Not every filesystem supports O_DIRECT (e.g. tmpfs), those fall back to IO_BUFFERED
+            fd = VCWD_OPEN(path, O_RDONLY | O_BINARY | O_DIRECT);
+            direct = fd >= 0;
         }
-    } else {
-        php_error_docref(NULL, E_WARNING, "Invalid checksum1 length (expected %zu bytes for binary or %zu chars for hex)",
-                         expected_binary_size, expected_hex_size);
-        RETURN_FALSE;
-    }
+#endif
+        if (fd < 0) {
+            fd = VCWD_OPEN(path, O_RDONLY | O_BINARY);
+        }
+        if (fd < 0) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "Failed to open file '%s'", filename);
+            return;
+        }
+#if !defined(O_DIRECT) && defined(F_NOCACHE)
+        // macOS has no O_DIRECT, but can skip the page cache without any alignment requirements
+        if (io_mode == PHP_CRC_FAST_IO_DIRECT) {
+            fcntl(fd, F_NOCACHE, 1);
+        }
+#endif
 
-    // Process checksum2
-    if (checksum2_len == expected_binary_size) {
-        // Binary input
-        if (is_crc32) {
-            cs2 = ntohl(*((uint32_t*)checksum2));
-        } else {
-            cs2 = PHP_NTOHLL(*((uint64_t*)checksum2));
+        zend_stat_t sb;
+        if (zend_fstat(fd, &sb) != 0) {
+            close(fd);
+            zend_throw_exception_ex(zend_ce_exception, 0, "Failed to stat file '%s'", filename);
+            return;
         }
-    } else if (checksum2_len == expected_hex_size) {
-        // Hex input
-        if (is_crc32) {
-            uint32_t value = 0;
-            if (sscanf(checksum2, "%8x", &value) == 1) {
-                cs2 = value;
+
+        stats_bytes = (uint64_t)sb.st_size;
+        php_crc_fast_io_status status = php_crc_fast_checksum_fd_io(
+            fd, (uint64_t)sb.st_size, io_mode, direct,
+            chunk_size_is_null ? PHP_CRC_FAST_DEFAULT_CHUNK_SIZE : (size_t)chunk_size, (size_t)queue_depth,
+            is_custom, algo, custom_params, &result);
+        close(fd);
+
+        if (status == PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "Failed to allocate buffers to read file '%s'", filename);
+            return;
+        }
+        if (status != PHP_CRC_FAST_IO_STATUS_OK) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "Failed to read file '%s'", filename);
+            return;
+        }
+    } else if (wrapper == &php_plain_files_wrapper && chunk_size_is_null) {
+        // Check if file exists and is readable
+        if (php_check_open_basedir(path)) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not within the allowed path(s)", filename);
+            return;
+        }
+
+        try {
+            if (is_custom) {
+                result = crc_fast_checksum_file_with_params(custom_params, (const uint8_t*)path, strlen(path));
             } else {
-                php_error_docref(NULL, E_WARNING, "Invalid hexadecimal input for checksum2");
-                RETURN_FALSE;
+                result = crc_fast_checksum_file(algo, (const uint8_t*)path, strlen(path));
             }
-        } else {
-            // For 64-bit values, parse it manually
-            cs2 = 0;
-            for (size_t i = 0; i < 16; i++) {
-                char c = checksum2[i];
-                uint64_t digit;
-
-                if (c >= '0' && c <= '9') {
-                    digit = c - '0';
-                } else if (c >= 'a' && c <= 'f') {
-                    digit = c - 'a' + 10;
-                } else if (c >= 'A' && c <= 'F') {
-                    digit = c - 'A' + 10;
-                } else {
-                    php_error_docref(NULL, E_WARNING, "Invalid hexadecimal character in checksum2");
-                    RETURN_FALSE;
-                }
+        } catch (...) {
+            zend_throw_exception_ex(zend_ce_exception, 0, 
+                "Failed to compute CRC checksum for file '%s'", filename);
+            return;
+        }
 
-                cs2 = (cs2 << 4) | digit;
-            }
+        // The library doesn't report how much it read, so only pay for a stat() when it's being counted
+        zend_stat_t sb;
+        if (php_crc_fast_stats_enabled && VCWD_STAT(path, &sb) == 0) {
+            stats_bytes = (uint64_t)sb.st_size;
         }
     } else {
-        php_error_docref(NULL, E_WARNING, "Invalid checksum2 length (expected %zu bytes for binary or %zu chars for hex)",
-                         expected_binary_size, expected_hex_size);
-        RETURN_FALSE;
+        // open_basedir is enforced by the wrappers themselves
+        php_stream *stream = php_stream_open_wrapper(filename, "rb", 0, NULL);
+        if (!stream) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "Failed to open file '%s'", filename);
+            return;
+        }
+
+        CrcFastDigestHandle *digest = is_custom ? crc_fast_digest_new_with_params(custom_params) : crc_fast_digest_new(algo);
+        if (!digest) {
+            php_stream_close(stream);
+            zend_throw_exception(zend_ce_exception, "C library failed to create digest", 0);
+            return;
+        }
+
+        size_t consumed;
+        bool success = php_crc_fast_digest_update_from_stream(
+            digest, stream, chunk_size_is_null ? PHP_CRC_FAST_DEFAULT_CHUNK_SIZE : (size_t)chunk_size, SIZE_MAX, &consumed);
+        php_stream_close(stream);
+        stats_bytes = consumed;
+
+        result = crc_fast_digest_finalize(digest);
+        crc_fast_digest_free(digest);
+
+        if (!success) {
+            zend_throw_exception_ex(zend_ce_exception, 0, "Failed to read file '%s'", filename);
+            return;
+        }
     }
 
-    uint64_t result;
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_FILE, algorithm, is_custom, stats_bytes, stats_start);
+
     if (is_custom) {
-        // Use custom parameters - handle potential C library errors
-        try {
-            result = crc_fast_checksum_combine_with_params(custom_params, cs1, cs2, length2);
-        } catch (...) {
-            zend_throw_exception(zend_ce_exception, "Failed to combine CRC checksums with custom parameters", 0);
-            return;
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, output_format, true, custom_params.width);
+    } else {
+        // Apply byte reversal if needed
+        result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
+
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, output_format);
+    }
+}
+/* }}} */
+
+/* Helper function to build the result of CrcFast\hash_chunks() and CrcFast\hash_file_chunks() from the raw part
+ * checksums, with the whole checksum combined from the parts rather than hashed again */
+static void php_crc_fast_chunks_result(
+    zval *return_value,
+    const std::vector<uint64_t> &checksums,
+    const std::vector<uint64_t> &lengths,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &custom_params,
+    zend_long algorithm,
+    zend_long format,
+    zend_bool packed)
+{
+    bool is_32bit = php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0);
+    size_t size = is_32bit ? 4 : 8;
+
+    uint64_t whole = is_custom ? crc_fast_checksum_with_params(custom_params, "", 0) : crc_fast_checksum(algo, "", 0);
+    for (size_t i = 0; i < checksums.size(); i++) {
+        if (i == 0) {
+            whole = checksums[0];
+        } else if (is_custom) {
+            whole = crc_fast_checksum_combine_with_params(custom_params, whole, checksums[i], lengths[i]);
+        } else {
+            whole = crc_fast_checksum_combine(algo, whole, checksums[i], lengths[i]);
+        }
+    }
+
+    zval chunks;
+    if (packed) {
+        // Big-endian checksums back to back, e.g. for S3's checksum-of-checksums
+        zend_string *str = zend_string_alloc(checksums.size() * size, 0);
+        char *out = ZSTR_VAL(str);
+        for (uint64_t checksum : checksums) {
+            checksum = is_custom ? checksum : php_crc_fast_reverse_bytes_if_needed(checksum, algorithm);
+            for (size_t i = 0; i < size; i++) {
+                *out++ = (char)(checksum >> (8 * (size - 1 - i)));
+            }
         }
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, binary, true, custom_params.width);
+        *out = '\0';
+        ZVAL_STR(&chunks, str);
     } else {
-        // Use predefined algorithm - handle potential C library errors
-        CrcFastAlgorithm algo = php_crc_fast_get_algorithm(algorithm);
+        array_init_size(&chunks, (uint32_t)checksums.size());
+        for (uint64_t checksum : checksums) {
+            checksum = is_custom ? checksum : php_crc_fast_reverse_bytes_if_needed(checksum, algorithm);
+            zval part;
+            php_crc_fast_result_to_zval(&part, checksum, is_32bit, format);
+            add_next_index_zval(&chunks, &part);
+        }
+    }
+
+    whole = is_custom ? whole : php_crc_fast_reverse_bytes_if_needed(whole, algorithm);
+
+    array_init_size(return_value, 2);
+    add_assoc_zval(return_value, "chunks", &chunks);
+
+    zval checksum;
+    php_crc_fast_result_to_zval(&checksum, whole, is_32bit, format);
+    add_assoc_zval(return_value, "checksum", &checksum);
+}
+
+/* {{{ CrcFast\hash_chunks(int|CrcFast\Params $algorithm, string $data, int $chunk_size, bool $binary = false, bool $packed = false, ?int $format = null): array */
+PHP_FUNCTION(CrcFast_hash_chunks)
+{
+    zval *algorithm_zval;
+    char *data;
+    size_t data_len;
+    zend_long chunk_size;
+    zend_bool binary = 0;
+    zend_bool packed = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(3, 6)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_STRING(data, data_len)
+        Z_PARAM_LONG(chunk_size)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_BOOL(packed)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    if (chunk_size <= 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Chunk size must be positive, got %lld", chunk_size);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
         if (EG(exception)) {
             return; // Exception was thrown by get_algorithm
         }
-        
+    }
+
+    if (!php_crc_fast_check_format(output_format, php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0))) {
+        return;
+    }
+
+    // Each part is hashed in place, no substr() copies
+    size_t count = data_len / (size_t)chunk_size + (data_len % (size_t)chunk_size != 0);
+    if (count > PHP_CRC_FAST_MAX_CHUNKS) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Too many chunks, at most %d are supported. Use a larger chunk size", PHP_CRC_FAST_MAX_CHUNKS);
+        return;
+    }
+
+    std::vector<uint64_t> checksums;
+    std::vector<uint64_t> lengths;
+    try {
+        checksums.resize(count);
+        lengths.resize(count);
+    } catch (const std::bad_alloc &) {
+        zend_throw_exception(zend_ce_exception, "Failed to allocate memory for the chunk checksums", 0);
+        return;
+    }
+
+    uint64_t stats_start = php_crc_fast_stats_start();
+    for (size_t i = 0; i < count; i++) {
+        size_t offset = i * (size_t)chunk_size;
+        lengths[i] = MIN((size_t)chunk_size, data_len - offset);
+        checksums[i] = is_custom
+            ? crc_fast_checksum_with_params(custom_params, data + offset, lengths[i])
+            : crc_fast_checksum(algo, data + offset, lengths[i]);
+    }
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_CHUNKS, algorithm, is_custom, data_len, stats_start);
+
+    php_crc_fast_chunks_result(return_value, checksums, lengths, is_custom, algo, custom_params, algorithm, output_format, packed);
+}
+/* }}} */
+
+/* {{{ CrcFast\hash_file_chunks(int|CrcFast\Params $algorithm, string $filename, int $chunk_size, bool $binary = false, bool $packed = false, ?int $format = null): array */
+PHP_FUNCTION(CrcFast_hash_file_chunks)
+{
+    zval *algorithm_zval;
+    char *filename;
+    size_t filename_len;
+    zend_long chunk_size;
+    zend_bool binary = 0;
+    zend_bool packed = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(3, 6)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_PATH(filename, filename_len)
+        Z_PARAM_LONG(chunk_size)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_BOOL(packed)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    if (filename_len == 0) {
+        zend_throw_exception(zend_ce_exception, "Filename cannot be empty", 0);
+        return;
+    }
+
+    if (chunk_size <= 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Chunk size must be positive, got %lld", chunk_size);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    if (!php_crc_fast_check_format(output_format, php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0))) {
+        return;
+    }
+
+    // open_basedir is enforced by the wrappers themselves
+    php_stream *stream = php_stream_open_wrapper(filename, "rb", 0, NULL);
+    if (!stream) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to open file '%s'", filename);
+        return;
+    }
+
+    // Plain files (and anything else that knows its size) can be turned away before reading anything
+    php_stream_statbuf ssb;
+    if (php_stream_stat(stream, &ssb) == 0 && (ssb.sb.st_mode & S_IFMT) == S_IFREG
+        && ((uint64_t)ssb.sb.st_size + (uint64_t)chunk_size - 1) / (uint64_t)chunk_size > PHP_CRC_FAST_MAX_CHUNKS) {
+        php_stream_close(stream);
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Too many chunks, at most %d are supported. Use a larger chunk size", PHP_CRC_FAST_MAX_CHUNKS);
+        return;
+    }
+
+    CrcFastDigestHandle *digest = is_custom ? crc_fast_digest_new_with_params(custom_params) : crc_fast_digest_new(algo);
+    if (!digest) {
+        php_stream_close(stream);
+        zend_throw_exception(zend_ce_exception, "C library failed to create digest", 0);
+        return;
+    }
+
+    std::vector<uint64_t> checksums;
+    std::vector<uint64_t> lengths;
+    bool success = true;
+    bool too_many = false;
+    bool alloc_failed = false;
+    uint64_t stats_start = php_crc_fast_stats_start();
+    uint64_t stats_bytes = 0;
+
+    // One part at a time, read in buffer-sized pieces so large parts don't need to fit in memory
+    while (success) {
+        size_t consumed;
+        success = php_crc_fast_digest_update_from_stream(
+            digest, stream, PHP_CRC_FAST_DEFAULT_CHUNK_SIZE, (size_t)chunk_size, &consumed);
+
+        if (consumed == 0) {
+            break;
+        }
+
+        // Streams that can't say how big they are are stopped here instead
+        if (checksums.size() >= PHP_CRC_FAST_MAX_CHUNKS) {
+            too_many = true;
+            break;
+        }
+
         try {
-            result = crc_fast_checksum_combine(algo, cs1, cs2, length2);
-        } catch (...) {
-            zend_throw_exception_ex(zend_ce_exception, 0, 
-                "Failed to combine CRC checksums for algorithm %lld", algorithm);
-            return;
+            checksums.push_back(crc_fast_digest_finalize_reset(digest));
+            lengths.push_back(consumed);
+        } catch (const std::bad_alloc &) {
+            alloc_failed = true;
+            break;
         }
+        stats_bytes += consumed;
 
-        // Apply byte reversal if needed
-        result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
+        if (consumed < (size_t)chunk_size) {
+            break;
+        }
+    }
+
+    php_stream_close(stream);
+    crc_fast_digest_free(digest);
+
+    if (too_many) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Too many chunks, at most %d are supported. Use a larger chunk size", PHP_CRC_FAST_MAX_CHUNKS);
+        return;
+    }
+    if (alloc_failed) {
+        zend_throw_exception(zend_ce_exception, "Failed to allocate memory for the chunk checksums", 0);
+        return;
+    }
+    if (!success) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to read file '%s'", filename);
+        return;
+    }
+
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_FILE, algorithm, is_custom, stats_bytes, stats_start);
+
+    php_crc_fast_chunks_result(return_value, checksums, lengths, is_custom, algo, custom_params, algorithm, output_format, packed);
+}
+/* }}} */
+
+/* Native file hashing
+ *
+ * These run on worker threads as well as the PHP thread, so they must not touch any PHP APIs (including
+ * emalloc), and only use the file descriptor, algorithm, and params handed to them. */
+
+/* Helper function to read from a file descriptor at an offset, without moving a shared file position */
+static ssize_t php_crc_fast_pread(int fd, char *buf, size_t count, uint64_t offset)
+{
+#ifdef PHP_WIN32
+    HANDLE handle = (HANDLE)_get_osfhandle(fd);
+    OVERLAPPED overlapped = {0};
+    DWORD read = 0;
+
+    overlapped.Offset = (DWORD)(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+    if (!ReadFile(handle, buf, (DWORD)count, &read, &overlapped)) {
+        return GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    }
+
+    return (ssize_t)read;
+#else
+    ssize_t read;
+
+    do {
+        read = pread(fd, buf, count, (off_t)offset);
+    } while (read < 0 && errno == EINTR);
+
+    return read;
+#endif
+}
+
+/* Helper function to checksum [offset, offset + length) of a file descriptor, giving up early (and failing) if
+ * cancelled is set */
+static bool php_crc_fast_checksum_fd_range(
+    int fd,
+    uint64_t offset,
+    uint64_t length,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out,
+    const std::atomic<bool> *cancelled = NULL)
+{
+    CrcFastDigestHandle *digest = is_custom ? crc_fast_digest_new_with_params(params) : crc_fast_digest_new(algo);
+    if (!digest) {
+        return false;
+    }
+
+    size_t buf_size = (size_t)MIN(length, (uint64_t)PHP_CRC_FAST_DEFAULT_CHUNK_SIZE);
+    std::vector<char> buf(buf_size > 0 ? buf_size : 1);
+    bool success = true;
+
+    while (length > 0) {
+        if (cancelled && cancelled->load(std::memory_order_relaxed)) {
+            success = false;
+            break;
+        }
+
+        ssize_t read = php_crc_fast_pread(fd, buf.data(), (size_t)MIN(length, (uint64_t)buf.size()), offset);
+        if (read <= 0) {
+            // errors, or the file shrank underneath us
+            success = false;
+            break;
+        }
+
+        crc_fast_digest_update(digest, buf.data(), (size_t)read);
+        offset += (uint64_t)read;
+        length -= (uint64_t)read;
+    }
+
+    *result_out = crc_fast_digest_finalize(digest);
+    crc_fast_digest_free(digest);
+
+    return success;
+}
+
+/* Helper function to checksum the first length bytes of a file descriptor with sequential reads of chunk_size,
+ * telling the kernel to read ahead and to drop each chunk from the page cache once it's hashed. With direct set,
+ * the file was opened with O_DIRECT, so reads go into an aligned buffer and are rounded up to the alignment. */
+static php_crc_fast_io_status php_crc_fast_checksum_fd_sequential(
+    int fd,
+    uint64_t length,
+    size_t chunk_size,
+    bool direct,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out)
+{
+    CrcFastDigestHandle *digest = is_custom ? crc_fast_digest_new_with_params(params) : crc_fast_digest_new(algo);
+    if (!digest) {
+        return PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED;
+    }
+
+    if (direct) {
+        chunk_size = (chunk_size + PHP_CRC_FAST_DIRECT_ALIGNMENT - 1) & ~((size_t)PHP_CRC_FAST_DIRECT_ALIGNMENT - 1);
+    } else {
+        chunk_size = (size_t)MAX((uint64_t)1, MIN(length, (uint64_t)chunk_size));
+    }
+
+    char *buf = NULL;
+#ifdef PHP_WIN32
+    buf = (char *)malloc(chunk_size);
+#else
+    if (posix_memalign((void **)&buf, PHP_CRC_FAST_DIRECT_ALIGNMENT, chunk_size) != 0) {
+        buf = NULL;
+    }
+#endif
+    if (!buf) {
+        crc_fast_digest_free(digest);
+        return PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED;
+    }
+
+#ifdef POSIX_FADV_SEQUENTIAL
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    uint64_t offset = 0;
+    bool success = true;
+
+    while (offset < length) {
+#ifdef O_DIRECT
+        if (direct && offset % PHP_CRC_FAST_DIRECT_ALIGNMENT != 0) {
+            // A short O_DIRECT read left the offset unaligned, which the next one would fail with EINVAL,
+            // so read the rest without O_DIRECT
+            int flags = fcntl(fd, F_GETFL);
+            if (flags < 0 || fcntl(fd, F_SETFL, flags & ~O_DIRECT) < 0) {
+                success = false;
+                break;
+            }
+            direct = false;
+        }
+#endif
+
+        // O_DIRECT reads must stay a multiple of the alignment, even past the end of the file
+        size_t count = direct ? chunk_size : (size_t)MIN(length - offset, (uint64_t)chunk_size);
+        ssize_t read = php_crc_fast_pread(fd, buf, count, offset);
+        if (read <= 0) {
+            // errors, or the file shrank underneath us
+            success = false;
+            break;
+        }
+
+        size_t used = (size_t)MIN((uint64_t)read, length - offset);
+        crc_fast_digest_update(digest, buf, used);
+
+#ifdef POSIX_FADV_DONTNEED
+        posix_fadvise(fd, (off_t)offset, (off_t)used, POSIX_FADV_DONTNEED);
+#endif
+
+        offset += used;
+    }
+
+    *result_out = crc_fast_digest_finalize(digest);
+    crc_fast_digest_free(digest);
+    free(buf);
+
+    return success ? PHP_CRC_FAST_IO_STATUS_OK : PHP_CRC_FAST_IO_STATUS_READ_FAILED;
+}
+
+#ifndef PHP_WIN32
+/* Helper function to checksum the first length bytes of a file descriptor by memory-mapping it */
+static bool php_crc_fast_checksum_fd_mmap(
+    int fd,
+    uint64_t length,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out)
+{
+    if (length == 0) {
+        *result_out = is_custom ? crc_fast_checksum_with_params(params, "", 0) : crc_fast_checksum(algo, "", 0);
+        return true;
+    }
+
+    if (length > (uint64_t)SIZE_MAX) {
+        return false;
+    }
+
+    void *map = mmap(NULL, (size_t)length, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    madvise(map, (size_t)length, MADV_SEQUENTIAL);
+#endif
+
+    *result_out = is_custom
+        ? crc_fast_checksum_with_params(params, (const char *)map, (size_t)length)
+        : crc_fast_checksum(algo, (const char *)map, (size_t)length);
+
+    munmap(map, (size_t)length);
+
+    return true;
+}
+#endif
+
+#ifdef HAVE_CRC_FAST_IO_URING
+/* Helper function to checksum the first length bytes of a file descriptor with io_uring, keeping up to queue_depth
+ * reads of chunk_size in flight. Each read has its own slot in a ring of buffers, which are hashed in order. Falls
+ * back to buffered reads if the kernel won't set up a ring, e.g. when a container's seccomp profile blocks io_uring. */
+static php_crc_fast_io_status php_crc_fast_checksum_fd_uring(
+    int fd,
+    uint64_t length,
+    size_t chunk_size,
+    size_t queue_depth,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out)
+{
+    chunk_size = (size_t)MAX((uint64_t)1, MIN(length, (uint64_t)chunk_size));
+    queue_depth = (size_t)MAX((uint64_t)1, MIN((uint64_t)queue_depth, (length + chunk_size - 1) / chunk_size));
+
+    // each read's size has to fit the unsigned length io_uring_prep_read() takes
+    if (chunk_size > UINT_MAX || chunk_size > SIZE_MAX / queue_depth) {
+        return PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED;
+    }
+
+    struct io_uring ring;
+    if (io_uring_queue_init((unsigned)queue_depth, &ring, 0) < 0) {
+        return php_crc_fast_checksum_fd_sequential(fd, length, chunk_size, false, is_custom, algo, params, result_out);
+    }
+
+    std::vector<char> buf;
+    std::vector<uint64_t> offsets;
+    std::vector<size_t> expected;
+    std::vector<int> results;
+    std::vector<char> completed;
+    try {
+        buf.resize(chunk_size * queue_depth);
+        offsets.resize(queue_depth, 0);
+        expected.resize(queue_depth, 0);
+        results.resize(queue_depth, 0);
+        completed.resize(queue_depth, 0);
+    } catch (const std::bad_alloc &) {
+        io_uring_queue_exit(&ring);
+        return PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED;
+    }
+
+    CrcFastDigestHandle *digest = is_custom ? crc_fast_digest_new_with_params(params) : crc_fast_digest_new(algo);
+    if (!digest) {
+        io_uring_queue_exit(&ring);
+        return PHP_CRC_FAST_IO_STATUS_ALLOC_FAILED;
+    }
+
+    uint64_t submit_offset = 0;
+    uint64_t hash_offset = 0;
+    size_t head = 0;  // Slot holding the read at hash_offset
+    size_t pending = 0;  // Reads prepared but not yet taken by the kernel
+    size_t in_flight = 0;  // Reads the kernel has taken, whose completions are still to come
+    bool success = true;
+
+    auto submit = [&](size_t slot) {
+        struct io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+        if (!sqe) {
+            return false;
+        }
+
+        offsets[slot] = submit_offset;
+        expected[slot] = (size_t)MIN(length - submit_offset, (uint64_t)chunk_size);
+        completed[slot] = 0;
+        io_uring_prep_read(sqe, fd, &buf[slot * chunk_size], (unsigned)expected[slot], submit_offset);
+        io_uring_sqe_set_data(sqe, (void *)(uintptr_t)slot);
+        submit_offset += expected[slot];
+        pending++;
+
+        return true;
+    };
+
+    // only reads the kernel has actually taken count as in flight, so the waits below can't block forever
+    auto flush = [&]() {
+        while (pending > 0) {
+            int ret = io_uring_submit(&ring);
+            if (ret == -EINTR) {
+                continue;
+            }
+            if (ret <= 0) {
+                return false;
+            }
+            pending -= MIN((size_t)ret, pending);
+            in_flight += (size_t)ret;
+        }
+
+        return true;
+    };
+
+    // fill the queue, slots are reused in order so they always hold consecutive ranges
+    for (size_t slot = 0; slot < queue_depth && submit_offset < length; slot++) {
+        if (!submit(slot)) {
+            success = false;
+            break;
+        }
+    }
+    if (success && !flush()) {
+        success = false;
+    }
+
+    while (success && hash_offset < length) {
+        while (!completed[head]) {
+            if (in_flight == 0) {
+                success = false;
+                break;
+            }
+
+            struct io_uring_cqe *cqe;
+            int ret = io_uring_wait_cqe(&ring, &cqe);
+            if (ret == -EINTR) {
+                continue;
+            }
+            if (ret < 0) {
+                success = false;
+                break;
+            }
+
+            size_t slot = (size_t)(uintptr_t)io_uring_cqe_get_data(cqe);
+            results[slot] = cqe->res;
+            completed[slot] = 1;
+            io_uring_cqe_seen(&ring, cqe);
+            in_flight--;
+        }
+
+        if (!success || results[head] <= 0) {
+            // errors, or the file shrank underneath us
+            success = false;
+            break;
+        }
+
+        // short reads are rare for regular files, but allowed, so finish those synchronously
+        size_t filled = (size_t)results[head];
+        while (filled < expected[head]) {
+            ssize_t read = php_crc_fast_pread(
+                fd, &buf[head * chunk_size + filled], expected[head] - filled, offsets[head] + filled);
+            if (read <= 0) {
+                success = false;
+                break;
+            }
+            filled += (size_t)read;
+        }
+        if (!success) {
+            break;
+        }
+
+        crc_fast_digest_update(digest, &buf[head * chunk_size], expected[head]);
+        hash_offset += expected[head];
+
+        if (submit_offset < length) {
+            if (!submit(head) || !flush()) {
+                success = false;
+                break;
+            }
+        }
+
+        head = (head + 1) % queue_depth;
+    }
+
+    // the kernel may still be writing into the buffers, so wait for everything before they go away
+    while (in_flight > 0) {
+        struct io_uring_cqe *cqe;
+        int ret = io_uring_wait_cqe(&ring, &cqe);
+        if (ret == -EINTR) {
+            continue;
+        }
+        if (ret < 0) {
+            break;
+        }
+        io_uring_cqe_seen(&ring, cqe);
+        in_flight--;
+    }
+
+    io_uring_queue_exit(&ring);
+
+    *result_out = crc_fast_digest_finalize(digest);
+    crc_fast_digest_free(digest);
+
+    return success ? PHP_CRC_FAST_IO_STATUS_OK : PHP_CRC_FAST_IO_STATUS_READ_FAILED;
+}
+#endif
+
+/* Helper function to checksum the first length bytes of a file descriptor with one of the PHP_CRC_FAST_IO_* modes
+ * other than PHP_CRC_FAST_IO_DEFAULT. For PHP_CRC_FAST_IO_DIRECT, direct says whether fd really has O_DIRECT set,
+ * since not every filesystem supports it. */
+static php_crc_fast_io_status php_crc_fast_checksum_fd_io(
+    int fd,
+    uint64_t length,
+    zend_long io_mode,
+    bool direct,
+    size_t chunk_size,
+    size_t queue_depth,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out)
+{
+    switch (io_mode) {
+#ifndef PHP_WIN32
+        case PHP_CRC_FAST_IO_MMAP:
+            return php_crc_fast_checksum_fd_mmap(fd, length, is_custom, algo, params, result_out)
+                ? PHP_CRC_FAST_IO_STATUS_OK : PHP_CRC_FAST_IO_STATUS_READ_FAILED;
+#endif
+#ifdef HAVE_CRC_FAST_IO_URING
+        case PHP_CRC_FAST_IO_URING:
+            return php_crc_fast_checksum_fd_uring(
+                fd, length, chunk_size, queue_depth, is_custom, algo, params, result_out);
+#endif
+        case PHP_CRC_FAST_IO_DIRECT:
+            return php_crc_fast_checksum_fd_sequential(
+                fd, length, chunk_size, direct, is_custom, algo, params, result_out);
+        default:
+            return php_crc_fast_checksum_fd_sequential(
+                fd, length, chunk_size, false, is_custom, algo, params, result_out);
+    }
+}
+
+/* Helper function to checksum [offset, offset + length) of a file descriptor, split over up to max_threads
+ * worker threads whose results are joined with combine */
+static bool php_crc_fast_checksum_fd_parallel(
+    int fd,
+    uint64_t offset,
+    uint64_t length,
+    size_t max_threads,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params,
+    uint64_t *result_out)
+{
+    // don't bother spinning up threads for ranges that are quicker to just checksum
+    uint64_t ranges = MAX((uint64_t)1, MIN((uint64_t)max_threads, length / PHP_CRC_FAST_PARALLEL_MIN_RANGE));
+    if (ranges == 1) {
+        return php_crc_fast_checksum_fd_range(fd, offset, length, is_custom, algo, params, result_out);
+    }
+
+    uint64_t range_length = length / ranges;
+    std::vector<uint64_t> lengths(ranges, range_length);
+    std::vector<uint64_t> results(ranges, 0);
+    std::vector<char> successes(ranges, 0);
+    std::vector<std::thread> workers;
+
+    // the last range picks up the remainder
+    lengths[ranges - 1] += length % ranges;
+
+    workers.reserve(ranges - 1);
+    for (uint64_t i = 1; i < ranges; i++) {
+        uint64_t range_offset = offset + i * range_length;
+        try {
+            workers.emplace_back([=, &params, &lengths, &results, &successes]() {
+                successes[i] = php_crc_fast_checksum_fd_range(
+                    fd, range_offset, lengths[i], is_custom, algo, params, &results[i]);
+            });
+        } catch (...) {
+            // couldn't start a thread, so do it ourselves
+            successes[i] = php_crc_fast_checksum_fd_range(
+                fd, range_offset, lengths[i], is_custom, algo, params, &results[i]);
+        }
+    }
+
+    // the calling thread takes the first range
+    successes[0] = php_crc_fast_checksum_fd_range(fd, offset, lengths[0], is_custom, algo, params, &results[0]);
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    uint64_t result = results[0];
+    bool success = successes[0];
+    for (uint64_t i = 1; i < ranges; i++) {
+        success = success && successes[i];
+        result = is_custom
+            ? crc_fast_checksum_combine_with_params(params, result, results[i], lengths[i])
+            : crc_fast_checksum_combine(algo, result, results[i], lengths[i]);
+    }
+
+    *result_out = result;
+
+    return success;
+}
+
+/* {{{ CrcFast\hash_file_parallel(int|CrcFast\Params $algorithm, string $filename, bool $binary = false, ?int $threads = null, ?int $format = null): string|int */
+PHP_FUNCTION(CrcFast_hash_file_parallel)
+{
+    zval *algorithm_zval;
+    char *filename;
+    size_t filename_len;
+    zend_bool binary = 0;
+    zend_long threads = 0;
+    bool threads_is_null = 1;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(2, 5)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_PATH(filename, filename_len)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(threads, threads_is_null)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    // Validate filename parameter
+    if (filename_len == 0) {
+        zend_throw_exception(zend_ce_exception, "Filename cannot be empty", 0);
+        return;
+    }
+
+    if (threads_is_null) {
+        threads = (zend_long)MAX(1U, std::thread::hardware_concurrency());
+    } else if (threads < 1 || threads > PHP_CRC_FAST_MAX_THREADS) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Thread count must be between 1 and %d, got %lld", PHP_CRC_FAST_MAX_THREADS, threads);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    // Ranges are read with pread(), so this only works on plain files
+    const char *path = filename;
+    if (php_stream_locate_url_wrapper(filename, &path, 0) != &php_plain_files_wrapper) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not a plain file", filename);
+        return;
+    }
+
+    // Check if file exists and is readable
+    if (php_check_open_basedir(path)) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not within the allowed path(s)", filename);
+        return;
+    }
+
+    int fd = VCWD_OPEN(path, O_RDONLY | O_BINARY);
+    if (fd < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to open file '%s'", filename);
+        return;
+    }
+
+    zend_stat_t sb;
+    if (zend_fstat(fd, &sb) != 0) {
+        close(fd);
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to stat file '%s'", filename);
+        return;
+    }
+
+    uint64_t stats_start = php_crc_fast_stats_start();
+    uint64_t result;
+    bool success = php_crc_fast_checksum_fd_parallel(
+        fd, 0, (uint64_t)sb.st_size, (size_t)threads, is_custom, algo, custom_params, &result);
+    close(fd);
+
+    if (!success) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to read file '%s'", filename);
+        return;
+    }
+
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_FILE, algorithm, is_custom, (uint64_t)sb.st_size, stats_start);
+
+    if (is_custom) {
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, output_format, true, custom_params.width);
+    } else {
+        // Apply byte reversal if needed
+        result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
+
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, output_format);
+    }
+}
+/* }}} */
+
+/* One file for CrcFast\hash_files() */
+typedef struct _php_crc_fast_file_job {
+    std::string path;  // Absolute, so workers don't depend on PHP's (virtual) working directory
+    int status;  // One of the PHP_CRC_FAST_FILE_* below
+    uint64_t result;
+} php_crc_fast_file_job;
+
+#define PHP_CRC_FAST_FILE_PENDING     0
+#define PHP_CRC_FAST_FILE_OK          1
+#define PHP_CRC_FAST_FILE_NOT_PLAIN   2
+#define PHP_CRC_FAST_FILE_BASEDIR     3
+#define PHP_CRC_FAST_FILE_OPEN_FAILED 4
+#define PHP_CRC_FAST_FILE_READ_FAILED 5
+
+/* Helper function to checksum the files of every pending job, for each of a pool of worker threads which take the
+ * next job until there are none left. Only opening files and native hashing happens here, no PHP APIs. */
+static void php_crc_fast_file_jobs_run(
+    std::vector<php_crc_fast_file_job> &jobs,
+    std::atomic<size_t> &next,
+    zend_long algorithm,
+    bool is_custom,
+    CrcFastAlgorithm algo,
+    const CrcFastParams &params)
+{
+    for (size_t i = next++; i < jobs.size(); i = next++) {
+        php_crc_fast_file_job &job = jobs[i];
+        if (job.status != PHP_CRC_FAST_FILE_PENDING) {
+            continue;
+        }
+
+        int fd = open(job.path.c_str(), O_RDONLY | O_BINARY);
+        if (fd < 0) {
+            job.status = PHP_CRC_FAST_FILE_OPEN_FAILED;
+            continue;
+        }
+
+        zend_stat_t sb;
+        if (zend_fstat(fd, &sb) != 0) {
+            close(fd);
+            job.status = PHP_CRC_FAST_FILE_OPEN_FAILED;
+            continue;
+        }
+
+        uint64_t stats_start = php_crc_fast_stats_start();
+        bool success = php_crc_fast_checksum_fd_range(fd, 0, (uint64_t)sb.st_size, is_custom, algo, params, &job.result);
+        close(fd);
+
+        job.status = success ? PHP_CRC_FAST_FILE_OK : PHP_CRC_FAST_FILE_READ_FAILED;
+        if (success) {
+            php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_FILES, algorithm, is_custom, (uint64_t)sb.st_size, stats_start);
+        }
+    }
+}
+
+/* {{{ CrcFast\hash_files(int|CrcFast\Params $algorithm, array $paths, array $options = []): array */
+PHP_FUNCTION(CrcFast_hash_files)
+{
+    zval *algorithm_zval;
+    HashTable *paths;
+    HashTable *options = NULL;
+
+    ZEND_PARSE_PARAMETERS_START(2, 3)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_ARRAY_HT(paths)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_ARRAY_HT(options)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long threads = (zend_long)MAX(1U, std::thread::hardware_concurrency());
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    if (options) {
+        zend_string *key;
+        zval *value;
+        ZEND_HASH_FOREACH_STR_KEY_VAL(options, key, value) {
+            ZVAL_DEREF(value);
+            if (key && zend_string_equals_literal(key, "threads") && Z_TYPE_P(value) == IS_LONG) {
+                threads = Z_LVAL_P(value);
+                if (threads < 1 || threads > PHP_CRC_FAST_MAX_THREADS) {
+                    zend_throw_exception_ex(zend_ce_exception, 0,
+                        "Thread count must be between 1 and %d, got %lld", PHP_CRC_FAST_MAX_THREADS, threads);
+                    return;
+                }
+            } else if (key && zend_string_equals_literal(key, "binary") && (Z_TYPE_P(value) == IS_TRUE || Z_TYPE_P(value) == IS_FALSE)) {
+                binary = Z_TYPE_P(value) == IS_TRUE;
+            } else if (key && zend_string_equals_literal(key, "format") && Z_TYPE_P(value) == IS_LONG) {
+                format = Z_LVAL_P(value);
+                format_is_null = 0;
+            } else if (key && zend_string_equals_literal(key, "format") && Z_TYPE_P(value) == IS_NULL) {
+                format_is_null = 1;
+            } else {
+                zend_throw_exception_ex(zend_ce_exception, 0,
+                    "Invalid option \"%s\", expected \"threads\" (int), \"binary\" (bool), or \"format\" (?int)",
+                    key ? ZSTR_VAL(key) : "");
+                return;
+            }
+        } ZEND_HASH_FOREACH_END();
+    }
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    bool is_32bit = php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0);
+
+#if SIZEOF_ZEND_LONG == 4
+    if (output_format == PHP_CRC_FAST_FORMAT_INT && !is_32bit) {
+        zend_throw_exception(zend_ce_exception, "CRC-64 checksums cannot be returned as integers on 32-bit platforms", 0);
+        return;
+    }
+#endif
+
+    // Validate and resolve every path on this thread, since open_basedir, stream wrappers, and the working directory
+    // are all PHP state
+    std::vector<php_crc_fast_file_job> jobs;
+    jobs.reserve(zend_hash_num_elements(paths));
+
+    zend_ulong index;
+    zend_string *key;
+    zval *item;
+    ZEND_HASH_FOREACH_KEY_VAL(paths, index, key, item) {
+        ZVAL_DEREF(item);
+        if (Z_TYPE_P(item) != IS_STRING || Z_STRLEN_P(item) == 0 || CHECK_NULL_PATH(Z_STRVAL_P(item), Z_STRLEN_P(item))) {
+            if (key) {
+                zend_throw_exception_ex(zend_ce_exception, 0,
+                    "All paths must be non-empty strings, element \"%s\" is not", ZSTR_VAL(key));
+            } else {
+                zend_throw_exception_ex(zend_ce_exception, 0,
+                    "All paths must be non-empty strings, element " ZEND_ULONG_FMT " is not", index);
+            }
+            return;
+        }
+
+        const char *filename = Z_STRVAL_P(item);
+        const char *path = filename;
+        php_crc_fast_file_job job = {std::string(), PHP_CRC_FAST_FILE_PENDING, 0};
+
+        if (php_stream_locate_url_wrapper(filename, &path, 0) != &php_plain_files_wrapper) {
+            job.status = PHP_CRC_FAST_FILE_NOT_PLAIN;
+        } else if (php_check_open_basedir_ex(path, 0)) {
+            job.status = PHP_CRC_FAST_FILE_BASEDIR;
+        } else {
+            char *expanded = expand_filepath(path, NULL);
+            if (expanded) {
+                job.path = expanded;
+                efree(expanded);
+            } else {
+                job.status = PHP_CRC_FAST_FILE_OPEN_FAILED;
+            }
+        }
+
+        jobs.push_back(std::move(job));
+    } ZEND_HASH_FOREACH_END();
+
+    // Lots of small files are bound by open() and I/O latency rather than CPU, so every thread takes whole files
+    std::atomic<size_t> next(0);
+    size_t worker_count = (size_t)MIN((zend_long)jobs.size(), threads) - (jobs.empty() ? 0 : 1);
+    std::vector<std::thread> workers;
+
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; i++) {
+        try {
+            workers.emplace_back([&]() {
+                php_crc_fast_file_jobs_run(jobs, next, algorithm, is_custom, algo, custom_params);
+            });
+        } catch (...) {
+            // couldn't start a thread, so make do with the ones we have
+            break;
+        }
+    }
+
+    // the calling thread works through the queue too
+    php_crc_fast_file_jobs_run(jobs, next, algorithm, is_custom, algo, custom_params);
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    array_init_size(return_value, (uint32_t)jobs.size());
+
+    size_t i = 0;
+    ZEND_HASH_FOREACH_VAL(paths, item) {
+        ZVAL_DEREF(item);
+        php_crc_fast_file_job &job = jobs[i++];
+        const char *filename = Z_STRVAL_P(item);
+
+        zval value;
+        if (job.status == PHP_CRC_FAST_FILE_OK) {
+            uint64_t result = is_custom ? job.result : php_crc_fast_reverse_bytes_if_needed(job.result, algorithm);
+            if (output_format == PHP_CRC_FAST_FORMAT_INT) {
+                ZVAL_LONG(&value, (zend_long)result);
+            } else {
+                ZVAL_STR(&value, php_crc_fast_result_to_string(result, is_32bit, output_format));
+            }
+        } else {
+            // Failures don't stop the rest, they're returned in place of the checksum
+            zend_string *message;
+            switch (job.status) {
+                case PHP_CRC_FAST_FILE_NOT_PLAIN:
+                    message = zend_strpprintf(0, "File '%s' is not a plain file", filename);
+                    break;
+                case PHP_CRC_FAST_FILE_BASEDIR:
+                    message = zend_strpprintf(0, "File '%s' is not within the allowed path(s)", filename);
+                    break;
+                case PHP_CRC_FAST_FILE_OPEN_FAILED:
+                    message = zend_strpprintf(0, "Failed to open file '%s'", filename);
+                    break;
+                default:
+                    message = zend_strpprintf(0, "Failed to read file '%s'", filename);
+                    break;
+            }
+
+            object_init_ex(&value, zend_ce_exception);
+            zend_update_property_str(zend_ce_exception, Z_OBJ(value), "message", sizeof("message") - 1, message);
+            zend_string_release(message);
+        }
+
+        zend_symtable_update(Z_ARRVAL_P(return_value), Z_STR_P(item), &value);
+    } ZEND_HASH_FOREACH_END();
+}
+/* }}} */
+
+/* {{{ CrcFast\hash_file_range(int|CrcFast\Params $algorithm, string $filename, int $offset, ?int $length = null, bool $binary = false, ?int $format = null): string|int */
+PHP_FUNCTION(CrcFast_hash_file_range)
+{
+    zval *algorithm_zval;
+    char *filename;
+    size_t filename_len;
+    zend_long offset;
+    zend_long length = 0;
+    bool length_is_null = 1;
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(3, 6)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_PATH(filename, filename_len)
+        Z_PARAM_LONG(offset)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_LONG_OR_NULL(length, length_is_null)
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    // Validate filename parameter
+    if (filename_len == 0) {
+        zend_throw_exception(zend_ce_exception, "Filename cannot be empty", 0);
+        return;
+    }
+
+    if (offset < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Offset must be non-negative, got %lld", offset);
+        return;
+    }
+
+    if (!length_is_null && length < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Length must be non-negative, got %lld", length);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    // Ranges are read with pread(), so this only works on plain files
+    const char *path = filename;
+    if (php_stream_locate_url_wrapper(filename, &path, 0) != &php_plain_files_wrapper) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not a plain file", filename);
+        return;
+    }
+
+    // Check if file exists and is readable
+    if (php_check_open_basedir(path)) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not within the allowed path(s)", filename);
+        return;
+    }
+
+    int fd = VCWD_OPEN(path, O_RDONLY | O_BINARY);
+    if (fd < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to open file '%s'", filename);
+        return;
+    }
+
+    zend_stat_t sb;
+    if (zend_fstat(fd, &sb) != 0) {
+        close(fd);
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to stat file '%s'", filename);
+        return;
+    }
+
+    // A null length runs to the end of the file, anything else must fit inside it
+    uint64_t file_size = (uint64_t)sb.st_size;
+    uint64_t range_length = length_is_null ? file_size - MIN((uint64_t)offset, file_size) : (uint64_t)length;
+    if ((uint64_t)offset > file_size || range_length > file_size - (uint64_t)offset) {
+        close(fd);
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Range of %llu bytes at offset %lld is beyond the end of file '%s' (%llu bytes)",
+            (unsigned long long)range_length, offset, filename, (unsigned long long)file_size);
+        return;
+    }
+
+    uint64_t stats_start = php_crc_fast_stats_start();
+    uint64_t result;
+    bool success = php_crc_fast_checksum_fd_range(
+        fd, (uint64_t)offset, range_length, is_custom, algo, custom_params, &result);
+    close(fd);
+
+    if (!success) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to read file '%s'", filename);
+        return;
+    }
+
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_HASH_FILE, algorithm, is_custom, range_length, stats_start);
+
+    if (is_custom) {
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, output_format, true, custom_params.width);
+    } else {
+        // Apply byte reversal if needed
+        result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
+
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, output_format);
+    }
+}
+/* }}} */
+
+/* Background file hashing for CrcFast\hash_file_async()
+ *
+ * Worker threads only touch this state, never the PendingHash object or any PHP APIs. The object owns the state, and
+ * either takes it back off the queue or waits for it to be done before freeing it. */
+struct php_crc_fast_pending_state {
+    std::mutex mutex;
+    std::condition_variable done_cond;
+    std::atomic<bool> cancelled{false};  // Set when the PendingHash goes away, so the worker can stop early
+
+    // Guarded by mutex
+    bool done = false;
+    bool success = false;
+    uint64_t result = 0;
+    int notify_fds[2] = {-1, -1};  // Pipe written to once done, only created by getStream()
+
+    // Set before the worker starts, and read-only after
+    int fd = -1;  // Closed by the worker
+    uint64_t length = 0;
+    zend_long algorithm = 0;
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    bool is_custom = false;
+    CrcFastParams custom_params;
+    uint64_t custom_keys[23];  // Our own copy of custom_params.keys, which can outlive the Params object
+    zend_long format = PHP_CRC_FAST_FORMAT_HEX;
+};
+
+/* Helper function to wake up anything watching the getStream() stream, called with the mutex held */
+static void php_crc_fast_pending_notify(php_crc_fast_pending_state *state)
+{
+#ifndef PHP_WIN32
+    if (state->notify_fds[1] >= 0) {
+        char byte = 1;
+        ssize_t written;
+
+        do {
+            written = write(state->notify_fds[1], &byte, 1);
+        } while (written < 0 && errno == EINTR);
+    }
+#endif
+}
+
+/* Worker thread body */
+static void php_crc_fast_pending_run(php_crc_fast_pending_state *state)
+{
+    uint64_t stats_start = php_crc_fast_stats_start();
+    uint64_t result = 0;
+    bool success = php_crc_fast_checksum_fd_range(
+        state->fd, 0, state->length, state->is_custom, state->algo, state->custom_params, &result, &state->cancelled);
+    close(state->fd);
+
+    if (success) {
+        php_crc_fast_stats_record(
+            PHP_CRC_FAST_STATS_HASH_ASYNC, state->algorithm, state->is_custom, state->length, stats_start);
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->result = result;
+    state->success = success;
+    state->done = true;
+    php_crc_fast_pending_notify(state);
+    state->done_cond.notify_all();
+}
+
+/* Process-wide pool of worker threads for CrcFast\hash_file_async()
+ *
+ * Threads are started as work comes in, up to PHP_CRC_FAST_MAX_ASYNC_WORKERS, and then stay parked until MSHUTDOWN.
+ * Anything started while they're all busy waits in the queue, oldest first. */
+struct php_crc_fast_pending_pool_t {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<php_crc_fast_pending_state*> queue;
+    std::vector<std::thread> workers;
+    size_t idle = 0;
+    bool shutdown = false;
+#ifndef PHP_WIN32
+    pid_t pid = 0;  // Process the workers belong to, they don't survive a fork()
+#endif
+
+    ~php_crc_fast_pending_pool_t()
+    {
+        // Only reached with workers still around if the process exits without MSHUTDOWN, e.g. a forked child
+        for (std::thread &worker : workers) {
+            if (worker.joinable()) {
+                worker.detach();
+            }
+        }
+    }
+};
+
+static php_crc_fast_pending_pool_t php_crc_fast_pending_pool;
+
+/* Worker thread body, taking states off the queue until shutdown */
+static void php_crc_fast_pending_worker()
+{
+    php_crc_fast_pending_pool_t *pool = &php_crc_fast_pending_pool;
+    std::unique_lock<std::mutex> lock(pool->mutex);
+
+    for (;;) {
+        pool->idle++;
+        pool->cond.wait(lock, [pool] { return pool->shutdown || !pool->queue.empty(); });
+        pool->idle--;
+
+        if (pool->queue.empty()) {
+            return;
+        }
+
+        php_crc_fast_pending_state *state = pool->queue.front();
+        pool->queue.pop_front();
+
+        lock.unlock();
+        php_crc_fast_pending_run(state);
+        lock.lock();
+    }
+}
+
+/* Helper function to queue a state for the pool, returning false if there's no thread to run it */
+static bool php_crc_fast_pending_submit(php_crc_fast_pending_state *state)
+{
+    php_crc_fast_pending_pool_t *pool = &php_crc_fast_pending_pool;
+    std::lock_guard<std::mutex> lock(pool->mutex);
+
+#ifndef PHP_WIN32
+    // Threads aren't copied into a forked child, so start over with new ones
+    if (pool->pid != getpid()) {
+        for (std::thread &worker : pool->workers) {
+            worker.detach();
+        }
+        pool->workers.clear();
+        pool->idle = 0;
+        pool->pid = getpid();
+    }
+#endif
+
+    pool->queue.push_back(state);
+
+    if (pool->idle < pool->queue.size() && pool->workers.size() < PHP_CRC_FAST_MAX_ASYNC_WORKERS) {
+        try {
+            pool->workers.emplace_back(php_crc_fast_pending_worker);
+        } catch (...) {
+            // the existing workers will get to it eventually, unless there aren't any
+            if (pool->workers.empty()) {
+                pool->queue.pop_back();
+                return false;
+            }
+        }
+    }
+
+    pool->cond.notify_one();
+    return true;
+}
+
+/* Helper function to take a state back off the queue, returning false if a worker already has it */
+static bool php_crc_fast_pending_unqueue(php_crc_fast_pending_state *state)
+{
+    php_crc_fast_pending_pool_t *pool = &php_crc_fast_pending_pool;
+    std::lock_guard<std::mutex> lock(pool->mutex);
+
+    auto it = std::find(pool->queue.begin(), pool->queue.end(), state);
+    if (it == pool->queue.end()) {
+        return false;
+    }
+
+    pool->queue.erase(it);
+    return true;
+}
+
+/* Helper function to stop and join the pool's workers, called from MSHUTDOWN */
+static void php_crc_fast_pending_pool_shutdown()
+{
+    php_crc_fast_pending_pool_t *pool = &php_crc_fast_pending_pool;
+
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->shutdown = true;
+    }
+    pool->cond.notify_all();
+
+    for (std::thread &worker : pool->workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    pool->workers.clear();
+}
+
+/* Helper function to wait for the worker, forever if timeout is negative, returning whether it's done */
+static bool php_crc_fast_pending_wait(php_crc_fast_pending_state *state, double timeout)
+{
+    std::unique_lock<std::mutex> lock(state->mutex);
+
+    // Anything longer than ~30 years might as well be forever, and would overflow the clock
+    if (timeout < 0 || timeout > 1e9) {
+        state->done_cond.wait(lock, [state] { return state->done; });
+    } else {
+        state->done_cond.wait_for(lock, std::chrono::duration<double>(timeout), [state] { return state->done; });
+    }
+
+    return state->done;
+}
+
+/* Helper function to get the state of a PendingHash, throwing if it didn't come from hash_file_async() */
+static php_crc_fast_pending_state *php_crc_fast_pending_get_state(zval *object)
+{
+    php_crc_fast_pending_hash_obj *obj = Z_CRC_FAST_PENDING_HASH_P(object);
+
+    if (!obj->state) {
+        zend_throw_exception(zend_ce_exception, "PendingHash objects can only be created by CrcFast\\hash_file_async()", 0);
+        return NULL;
+    }
+
+    return obj->state;
+}
+
+/* Free the PendingHash object */
+static void php_crc_fast_pending_hash_free_obj(zend_object *object)
+{
+    php_crc_fast_pending_hash_obj *obj = php_crc_fast_pending_hash_from_obj(object);
+
+    if (obj->state) {
+        if (php_crc_fast_pending_unqueue(obj->state)) {
+            // never started, so the file is still ours to close
+            close(obj->state->fd);
+        } else {
+            // Nobody can ask for the result any more, so let the worker stop at its next read
+            obj->state->cancelled.store(true, std::memory_order_relaxed);
+            php_crc_fast_pending_wait(obj->state, -1);
+        }
+
+#ifndef PHP_WIN32
+        if (obj->state->notify_fds[1] >= 0) {
+            close(obj->state->notify_fds[1]);
+        }
+        // Once getStream() has been called, the read end belongs to the stream
+        if (obj->state->notify_fds[0] >= 0 && Z_ISUNDEF(obj->stream)) {
+            close(obj->state->notify_fds[0]);
+        }
+#endif
+
+        delete obj->state;
+        obj->state = NULL;
+    }
+
+    zval_ptr_dtor(&obj->stream);
+
+    if (obj->filename) {
+        zend_string_release(obj->filename);
+        obj->filename = NULL;
+    }
+
+    zend_object_std_dtor(&obj->std);
+}
+
+/* Create a new PendingHash object */
+static zend_object *php_crc_fast_pending_hash_create_object(zend_class_entry *ce)
+{
+    php_crc_fast_pending_hash_obj *obj = (php_crc_fast_pending_hash_obj*)ecalloc(1, sizeof(php_crc_fast_pending_hash_obj) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&obj->std, ce);
+    object_properties_init(&obj->std, ce);
+
+    obj->std.handlers = &php_crc_fast_pending_hash_object_handlers;
+    obj->state = NULL;
+    obj->filename = NULL;
+    ZVAL_UNDEF(&obj->stream);
+
+    return &obj->std;
+}
+
+/* {{{ CrcFast\hash_file_async(int|CrcFast\Params $algorithm, string $filename, bool $binary = false, ?int $format = null): CrcFast\PendingHash */
+PHP_FUNCTION(CrcFast_hash_file_async)
+{
+    zval *algorithm_zval;
+    char *filename;
+    size_t filename_len;
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(2, 4)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_PATH(filename, filename_len)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    // Validate filename parameter
+    if (filename_len == 0) {
+        zend_throw_exception(zend_ce_exception, "Filename cannot be empty", 0);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    // The worker can't use PHP's stream wrappers, so this only works on plain files
+    const char *path = filename;
+    if (php_stream_locate_url_wrapper(filename, &path, 0) != &php_plain_files_wrapper) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not a plain file", filename);
+        return;
+    }
+
+    // Check if file exists and is readable
+    if (php_check_open_basedir(path)) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "File '%s' is not within the allowed path(s)", filename);
+        return;
+    }
+
+    // Open the file up front, so errors are thrown here rather than from result()
+    int fd = VCWD_OPEN(path, O_RDONLY | O_BINARY);
+    if (fd < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to open file '%s'", filename);
+        return;
+    }
+
+    zend_stat_t sb;
+    if (zend_fstat(fd, &sb) != 0) {
+        close(fd);
+        zend_throw_exception_ex(zend_ce_exception, 0, "Failed to stat file '%s'", filename);
+        return;
+    }
+
+    php_crc_fast_pending_state *state = new php_crc_fast_pending_state();
+    state->fd = fd;
+    state->length = (uint64_t)sb.st_size;
+    state->algorithm = algorithm;
+    state->algo = algo;
+    state->is_custom = is_custom;
+    state->format = output_format;
+    if (is_custom) {
+        state->custom_params = custom_params;
+        memcpy(state->custom_keys, custom_params.keys, sizeof(state->custom_keys));
+        state->custom_params.keys = state->custom_keys;
+    }
+
+    object_init_ex(return_value, php_crc_fast_pending_hash_ce);
+    php_crc_fast_pending_hash_obj *obj = Z_CRC_FAST_PENDING_HASH_P(return_value);
+    obj->state = state;
+    obj->filename = zend_string_init(filename, filename_len, 0);
+
+    if (!php_crc_fast_pending_submit(state)) {
+        // couldn't start a thread, so do it ourselves
+        php_crc_fast_pending_run(state);
+    }
+}
+/* }}} */
+
+/* {{{ CrcFast\PendingHash::__construct() */
+PHP_METHOD(CrcFast_PendingHash, __construct)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+}
+/* }}} */
+
+/* {{{ CrcFast\PendingHash::isDone(): bool */
+PHP_METHOD(CrcFast_PendingHash, isDone)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    php_crc_fast_pending_state *state = php_crc_fast_pending_get_state(getThis());
+    if (!state) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(state->mutex);
+    RETURN_BOOL(state->done);
+}
+/* }}} */
+
+/* {{{ CrcFast\PendingHash::wait(?float $timeout = null): bool */
+PHP_METHOD(CrcFast_PendingHash, wait)
+{
+    double timeout = 0;
+    bool timeout_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(0, 1)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_DOUBLE_OR_NULL(timeout, timeout_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    // written this way round to also catch NAN
+    if (!timeout_is_null && !(timeout >= 0)) {
+        zend_throw_exception_ex(zend_ce_exception, 0, "Timeout must be non-negative, got %F", timeout);
+        return;
+    }
+
+    php_crc_fast_pending_state *state = php_crc_fast_pending_get_state(getThis());
+    if (!state) {
+        return;
+    }
+
+    RETURN_BOOL(php_crc_fast_pending_wait(state, timeout_is_null ? -1 : timeout));
+}
+/* }}} */
+
+/* {{{ CrcFast\PendingHash::result(): string|int */
+PHP_METHOD(CrcFast_PendingHash, result)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    php_crc_fast_pending_state *state = php_crc_fast_pending_get_state(getThis());
+    if (!state) {
+        return;
+    }
+
+    php_crc_fast_pending_wait(state, -1);
+
+    // The worker is finished with these once done is set
+    if (!state->success) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Failed to read file '%s'", ZSTR_VAL(Z_CRC_FAST_PENDING_HASH_P(getThis())->filename));
+        return;
+    }
+
+    if (state->is_custom) {
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, state->result, state->format, true, state->custom_params.width);
+    } else {
+        // Apply byte reversal if needed
+        uint64_t result = php_crc_fast_reverse_bytes_if_needed(state->result, state->algorithm);
+
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, state->algorithm, result, state->format);
+    }
+}
+/* }}} */
+
+/* {{{ CrcFast\PendingHash::getStream(): resource */
+PHP_METHOD(CrcFast_PendingHash, getStream)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    php_crc_fast_pending_hash_obj *obj = Z_CRC_FAST_PENDING_HASH_P(getThis());
+    php_crc_fast_pending_state *state = php_crc_fast_pending_get_state(getThis());
+    if (!state) {
+        return;
+    }
+
+    if (Z_ISUNDEF(obj->stream)) {
+#ifdef PHP_WIN32
+        zend_throw_exception(zend_ce_exception, "Notification streams are not supported on Windows", 0);
+        return;
+#else
+        int fds[2];
+        if (pipe(fds) != 0) {
+            zend_throw_exception(zend_ce_exception, "Failed to create notification stream", 0);
+            return;
+        }
+
+        php_stream *stream = php_stream_fopen_from_fd(fds[0], "rb", NULL);
+        if (!stream) {
+            close(fds[0]);
+            close(fds[1]);
+            zend_throw_exception(zend_ce_exception, "Failed to create notification stream", 0);
+            return;
+        }
+
+        php_stream_to_zval(stream, &obj->stream);
+
+        // If the worker already finished, it had nothing to write to, so do it on its behalf
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->notify_fds[0] = fds[0];
+        state->notify_fds[1] = fds[1];
+        if (state->done) {
+            php_crc_fast_pending_notify(state);
+        }
+#endif
+    }
+
+    RETURN_COPY(&obj->stream);
+}
+/* }}} */
+
+/* The CrcFast\get_supported_algorithms() array, built once at MINIT and shared by every call */
+static HashTable *php_crc_fast_supported_algorithms = NULL;
+
+/* Helper function to add one algorithm to the CrcFast\get_supported_algorithms() array. Keys are interned, so
+ * requests on any thread can copy the array without touching a refcount. */
+static void php_crc_fast_supported_algorithms_add(HashTable *ht, const char *name, zend_long algorithm)
+{
+    zval id;
+    ZVAL_LONG(&id, algorithm);
+
+    zend_string *key = zend_string_init_interned(name, strlen(name), 1);
+    zend_hash_update(ht, key, &id);
+    zend_string_release(key);
+}
+
+/* Helper function to build the CrcFast\get_supported_algorithms() array, after the custom algorithms are loaded */
+static void php_crc_fast_supported_algorithms_build(void)
+{
+    HashTable *ht = (HashTable *) pemalloc(sizeof(HashTable), 1);
+    zend_hash_init(ht, PHP_CRC_FAST_ALGORITHM_COUNT + php_crc_fast_custom_algorithm_count, NULL, NULL, 1);
+
+    for (size_t i = 0; i < PHP_CRC_FAST_ALGORITHM_COUNT; i++) {
+        if (!php_crc_fast_algorithms[i].supported_name) {
+            continue;
+        }
+
+        php_crc_fast_supported_algorithms_add(ht, php_crc_fast_algorithms[i].supported_name, php_crc_fast_algorithms[i].id);
+    }
+
+    for (uint32_t i = 0; i < php_crc_fast_custom_algorithm_count; i++) {
+        php_crc_fast_supported_algorithms_add(ht, php_crc_fast_custom_algorithms[i].name, php_crc_fast_custom_algorithms[i].id);
+    }
+
+    // Never freed or changed by a request, any write separates it first
+    GC_SET_REFCOUNT(ht, 2);
+    GC_ADD_FLAGS(ht, IS_ARRAY_IMMUTABLE);
+
+    php_crc_fast_supported_algorithms = ht;
+}
+
+/* Helper function to free the CrcFast\get_supported_algorithms() array at MSHUTDOWN */
+static void php_crc_fast_supported_algorithms_free(void)
+{
+    if (php_crc_fast_supported_algorithms) {
+        zend_hash_destroy(php_crc_fast_supported_algorithms);
+        pefree(php_crc_fast_supported_algorithms, 1);
+        php_crc_fast_supported_algorithms = NULL;
+    }
+}
+
+/* {{{ CrcFast\get_supported_algorithms(): array */
+PHP_FUNCTION(CrcFast_get_supported_algorithms)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    // Immutable, so it's returned without copying, as opcache does for literal arrays
+    ZVAL_ARR(return_value, php_crc_fast_supported_algorithms);
+    Z_TYPE_FLAGS_P(return_value) = 0;
+}
+/* }}} */
+
+/* {{{ CrcFast\get_algorithm_info(int|CrcFast\Params $algorithm): array */
+PHP_FUNCTION(CrcFast_get_algorithm_info)
+{
+    zval *algorithm_zval;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_ZVAL(algorithm_zval)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    const php_crc_fast_algorithm_info *info;
+    php_crc_fast_algorithm_info custom_info;
+    if (is_custom) {
+        // Named custom algorithms have an id and a name, CrcFast\Params objects have neither
+        const php_crc_fast_custom_algorithm *custom = Z_TYPE_P(algorithm_zval) == IS_LONG
+            ? php_crc_fast_get_custom_algorithm(Z_LVAL_P(algorithm_zval)) : NULL;
+
+        custom_info = {
+            custom ? custom->id : 0, custom_params.algorithm, custom_params.width, custom_params.poly,
+            custom_params.init, custom_params.refin, custom_params.refout, custom_params.xorout, custom_params.check,
+            false, custom ? custom->name : NULL, custom ? custom->name : NULL, NULL
+        };
+        info = &custom_info;
+    } else {
+        info = php_crc_fast_find_algorithm(algorithm);
+        if (!info) {
+            php_crc_fast_get_algorithm(algorithm);  // Throws the usual invalid algorithm exception
+            return;
+        }
+    }
+
+    array_init_size(return_value, 13);
+
+    if (info->id) {
+        add_assoc_long(return_value, "id", info->id);
+    } else {
+        add_assoc_null(return_value, "id");
+    }
+    if (info->name) {
+        add_assoc_string(return_value, "name", info->name);
+    } else {
+        add_assoc_null(return_value, "name");
+    }
+    add_assoc_long(return_value, "width", info->width);
+    // Two's complement for CRC-64 values with the top bit set, as hash_int() and the Params getters return them
+    add_assoc_long(return_value, "poly", (zend_long)info->poly);
+    add_assoc_long(return_value, "init", (zend_long)info->init);
+    add_assoc_bool(return_value, "refin", info->refin);
+    add_assoc_bool(return_value, "refout", info->refout);
+    add_assoc_long(return_value, "xorout", (zend_long)info->xorout);
+    add_assoc_long(return_value, "check", (zend_long)info->check);
+    add_assoc_bool(return_value, "reverse_bytes", info->reverse_bytes);
+    if (info->supported_name) {
+        add_assoc_string(return_value, "supported_name", info->supported_name);
+    } else {
+        add_assoc_null(return_value, "supported_name");
+    }
+    if (info->hash_name) {
+        add_assoc_string(return_value, "hash_name", info->hash_name);
+    } else {
+        add_assoc_null(return_value, "hash_name");
+    }
+    add_assoc_string(return_value, "target", crc_fast_get_calculator_target(info->algorithm));
+}
+/* }}} */
+
+/* {{{ CrcFast\combine(int|CrcFast\Params $algorithm, string $checksum1, string $checksum2, int $length2, bool $binary = false, ?int $format = null): string|int */
+PHP_FUNCTION(CrcFast_combine)
+{
+    zval *algorithm_zval;
+    char *checksum1, *checksum2;
+    size_t checksum1_len, checksum2_len;
+    zend_long length2;
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(4, 6)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_STRING(checksum1, checksum1_len)
+        Z_PARAM_STRING(checksum2, checksum2_len)
+        Z_PARAM_LONG(length2)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    // Validate parameters
+    if (!checksum1 || !checksum2) {
+        zend_throw_exception(zend_ce_exception, "Checksum parameters cannot be null", 0);
+        return;
+    }
+
+    if (length2 < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0, 
+            "Length parameter must be non-negative, got %lld", length2);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    uint64_t cs1 = 0, cs2 = 0;
+
+    // Determine if we're dealing with 32-bit or 64-bit CRC
+    bool is_crc32;
+    if (is_custom) {
+        is_crc32 = (custom_params.width == 32);
+    } else {
+        is_crc32 = php_crc_fast_is_32bit(algorithm);
+    }
+    size_t expected_binary_size = is_crc32 ? 4 : 8;  // 4 bytes for CRC32, 8 bytes for CRC64
+    size_t expected_hex_size = is_crc32 ? 8 : 16;    // 8 hex chars for CRC32, 16 for CRC64
+
+    // Process checksum1
+    if (checksum1_len == expected_binary_size) {
+        // Binary input
+        if (is_crc32) {
+            cs1 = ntohl(*((uint32_t*)checksum1));
+        } else {
+            cs1 = PHP_NTOHLL(*((uint64_t*)checksum1));
+        }
+    } else if (checksum1_len == expected_hex_size) {
+        // Hex input
+        if (is_crc32) {
+            uint32_t value = 0;
+            if (sscanf(checksum1, "%8x", &value) == 1) {
+                cs1 = value;
+            } else {
+                php_error_docref(NULL, E_WARNING, "Invalid hexadecimal input for checksum1");
+                RETURN_FALSE;
+            }
+        } else {
+            // For 64-bit values, we need to parse it manually because sscanf might not
+            // handle uint64_t correctly on all platforms
+            cs1 = 0;
+            for (size_t i = 0; i < 16; i++) {
+                char c = checksum1[i];
+                uint64_t digit;
+
+                if (c >= '0' && c <= '9') {
+                    digit = c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    digit = c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    digit = c - 'A' + 10;
+                } else {
+                    php_error_docref(NULL, E_WARNING, "Invalid hexadecimal character in checksum1");
+                    RETURN_FALSE;
+                }
+
+                cs1 = (cs1 << 4) | digit;
+            }
+        }
+    } else {
+        php_error_docref(NULL, E_WARNING, "Invalid checksum1 length (expected %zu bytes for binary or %zu chars for hex)",
+                         expected_binary_size, expected_hex_size);
+        RETURN_FALSE;
+    }
+
+    // Process checksum2
+    if (checksum2_len == expected_binary_size) {
+        // Binary input
+        if (is_crc32) {
+            cs2 = ntohl(*((uint32_t*)checksum2));
+        } else {
+            cs2 = PHP_NTOHLL(*((uint64_t*)checksum2));
+        }
+    } else if (checksum2_len == expected_hex_size) {
+        // Hex input
+        if (is_crc32) {
+            uint32_t value = 0;
+            if (sscanf(checksum2, "%8x", &value) == 1) {
+                cs2 = value;
+            } else {
+                php_error_docref(NULL, E_WARNING, "Invalid hexadecimal input for checksum2");
+                RETURN_FALSE;
+            }
+        } else {
+            // For 64-bit values, parse it manually
+            cs2 = 0;
+            for (size_t i = 0; i < 16; i++) {
+                char c = checksum2[i];
+                uint64_t digit;
+
+                if (c >= '0' && c <= '9') {
+                    digit = c - '0';
+                } else if (c >= 'a' && c <= 'f') {
+                    digit = c - 'a' + 10;
+                } else if (c >= 'A' && c <= 'F') {
+                    digit = c - 'A' + 10;
+                } else {
+                    php_error_docref(NULL, E_WARNING, "Invalid hexadecimal character in checksum2");
+                    RETURN_FALSE;
+                }
+
+                cs2 = (cs2 << 4) | digit;
+            }
+        }
+    } else {
+        php_error_docref(NULL, E_WARNING, "Invalid checksum2 length (expected %zu bytes for binary or %zu chars for hex)",
+                         expected_binary_size, expected_hex_size);
+        RETURN_FALSE;
+    }
+
+    uint64_t result;
+    if (is_custom) {
+        // Use custom parameters - handle potential C library errors
+        try {
+            result = crc_fast_checksum_combine_with_params(custom_params, cs1, cs2, length2);
+        } catch (...) {
+            zend_throw_exception(zend_ce_exception, "Failed to combine CRC checksums with custom parameters", 0);
+            return;
+        }
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, output_format, true, custom_params.width);
+    } else {
+        // Use predefined algorithm - handle potential C library errors
+        CrcFastAlgorithm algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+        
+        try {
+            result = crc_fast_checksum_combine(algo, cs1, cs2, length2);
+        } catch (...) {
+            zend_throw_exception_ex(zend_ce_exception, 0, 
+                "Failed to combine CRC checksums for algorithm %lld", algorithm);
+            return;
+        }
+
+        // Apply byte reversal if needed
+        result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
+
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, output_format);
+    }
+}
+/* }}} */
+
+/* Helper function to decode a base64 checksum of size bytes, without allocating, rejecting anything that isn't
+ * exactly what FORMAT_BASE64 would produce */
+static bool php_crc_fast_parse_base64(const unsigned char *str, size_t len, size_t size, uint64_t *out)
+{
+    if (len != ((size + 2) / 3) * 4) {
+        return false;
+    }
+
+    uint64_t result = 0;
+    uint32_t buffer = 0;
+    size_t bits = 0;
+    size_t bytes = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = str[i];
+        uint32_t digit;
+
+        if (c >= 'A' && c <= 'Z') {
+            digit = c - 'A';
+        } else if (c >= 'a' && c <= 'z') {
+            digit = c - 'a' + 26;
+        } else if (c >= '0' && c <= '9') {
+            digit = c - '0' + 52;
+        } else if (c == '+') {
+            digit = 62;
+        } else if (c == '/') {
+            digit = 63;
+        } else if (c == '=') {
+            // only padding from here on
+            for (; i < len; i++) {
+                if (str[i] != '=') {
+                    return false;
+                }
+            }
+            break;
+        } else {
+            return false;
+        }
+
+        buffer = (buffer << 6) | digit;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            if (bytes == size) {
+                return false;
+            }
+            result = (result << 8) | ((buffer >> bits) & 0xFF);
+            bytes++;
+        }
+    }
+
+    // the leftover bits of the last digit must be zero
+    if (bytes != size || (buffer & ((1U << bits) - 1)) != 0) {
+        return false;
+    }
+
+    *out = result;
+    return true;
+}
+
+/* Helper function to parse a checksum given to CrcFast\combine_many() or CrcFast\verify() as an int, or a
+ * big-endian binary, hex, or base64 string, in the same form hash() / hash_int() return it */
+static bool php_crc_fast_parse_checksum(zval *value, bool is_32bit, uint64_t *out)
+{
+    size_t size = is_32bit ? 4 : 8;
+
+    if (Z_TYPE_P(value) == IS_LONG) {
+#if SIZEOF_ZEND_LONG == 4
+        // hash_int() results use all 32 bits here, so they may be negative
+        *out = (uint32_t)Z_LVAL_P(value);
+#else
+        if (is_32bit && (Z_LVAL_P(value) < 0 || (uint64_t)Z_LVAL_P(value) > 0xFFFFFFFFULL)) {
+            return false;
+        }
+        *out = (uint64_t)Z_LVAL_P(value);
+#endif
+        return true;
+    }
+
+    if (Z_TYPE_P(value) != IS_STRING) {
+        return false;
+    }
+
+    const unsigned char *str = (const unsigned char*)Z_STRVAL_P(value);
+    uint64_t result = 0;
+
+    if (Z_STRLEN_P(value) == size) {
+        for (size_t i = 0; i < size; i++) {
+            result = (result << 8) | str[i];
+        }
+    } else if (Z_STRLEN_P(value) == size * 2) {
+        for (size_t i = 0; i < size * 2; i++) {
+            unsigned char c = str[i];
+            uint64_t digit;
+
+            if (c >= '0' && c <= '9') {
+                digit = c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                digit = c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                digit = c - 'A' + 10;
+            } else {
+                // base64 of a CRC-32 is the same length, but always ends in "=="
+                return php_crc_fast_parse_base64(str, Z_STRLEN_P(value), size, out);
+            }
+
+            result = (result << 4) | digit;
+        }
+    } else {
+        return php_crc_fast_parse_base64(str, Z_STRLEN_P(value), size, out);
+    }
+
+    *out = result;
+    return true;
+}
+
+/* {{{ CrcFast\combine_many(int|CrcFast\Params $algorithm, array $parts, bool $binary = false, ?int $format = null): string|int */
+PHP_FUNCTION(CrcFast_combine_many)
+{
+    zval *algorithm_zval;
+    HashTable *parts;
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(2, 4)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_ARRAY_HT(parts)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    bool is_32bit = php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0);
+    uint32_t count = zend_hash_num_elements(parts);
+    std::vector<uint64_t> checksums;
+    std::vector<uint64_t> lengths;
+    checksums.reserve(count);
+    lengths.reserve(count);
+
+    uint32_t position = 0;
+    zval *part;
+    ZEND_HASH_FOREACH_VAL(parts, part) {
+        ZVAL_DEREF(part);
+
+        zval *checksum = NULL, *length = NULL;
+        if (Z_TYPE_P(part) == IS_ARRAY) {
+            checksum = zend_hash_index_find(Z_ARRVAL_P(part), 0);
+            length = zend_hash_index_find(Z_ARRVAL_P(part), 1);
+        }
+
+        if (!checksum || !length) {
+            zend_throw_exception_ex(zend_ce_exception, 0,
+                "Part %u must be an array of [checksum, length]", position);
+            return;
+        }
+
+        ZVAL_DEREF(checksum);
+        ZVAL_DEREF(length);
+
+        uint64_t value;
+        if (!php_crc_fast_parse_checksum(checksum, is_32bit, &value)) {
+            zend_throw_exception_ex(zend_ce_exception, 0,
+                "Part %u has an invalid checksum, expected an int, %u binary bytes, %u hex characters or %u base64 characters",
+                position, is_32bit ? 4 : 8, is_32bit ? 8 : 16, is_32bit ? 8 : 12);
+            return;
+        }
+
+        if (Z_TYPE_P(length) != IS_LONG || Z_LVAL_P(length) < 0) {
+            zend_throw_exception_ex(zend_ce_exception, 0,
+                "Part %u has an invalid length, expected a non-negative int", position);
+            return;
+        }
+
+        // Checksums are given in output form, so undo CRC-32/PHP's byte reversal before combining
+        checksums.push_back(is_custom ? value : php_crc_fast_reverse_bytes_if_needed(value, algorithm));
+        lengths.push_back((uint64_t)Z_LVAL_P(length));
+        position++;
+    } ZEND_HASH_FOREACH_END();
+
+    uint64_t result;
+    if (checksums.empty()) {
+        result = is_custom ? crc_fast_checksum_with_params(custom_params, "", 0) : crc_fast_checksum(algo, "", 0);
+    } else {
+        // Pairwise tree reduction: each round combines neighbours, so every combine works on similarly sized
+        // lengths and the number of rounds is logarithmic in the number of parts
+        for (size_t width = 1; width < checksums.size(); width *= 2) {
+            for (size_t i = 0; i + width < checksums.size(); i += width * 2) {
+                checksums[i] = is_custom
+                    ? crc_fast_checksum_combine_with_params(custom_params, checksums[i], checksums[i + width], lengths[i + width])
+                    : crc_fast_checksum_combine(algo, checksums[i], checksums[i + width], lengths[i + width]);
+                lengths[i] += lengths[i + width];
+            }
+        }
+        result = checksums[0];
+    }
+
+    if (is_custom) {
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, output_format, true, custom_params.width);
+    } else {
+        result = php_crc_fast_reverse_bytes_if_needed(result, algorithm);
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, output_format);
+    }
+}
+/* }}} */
+
+/* {{{ CrcFast\verify(int|CrcFast\Params $algorithm, string $data, string|int $expected): bool */
+PHP_FUNCTION(CrcFast_verify)
+{
+    zval *algorithm_zval;
+    char *data;
+    size_t data_len;
+    zval *expected_zval;
+
+    ZEND_PARSE_PARAMETERS_START(3, 3)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_STRING(data, data_len)
+        Z_PARAM_ZVAL(expected_zval)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    bool is_32bit = php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0);
+
+    uint64_t expected;
+    if (!php_crc_fast_parse_checksum(expected_zval, is_32bit, &expected)) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Invalid expected checksum, expected an int, %u binary bytes, %u hex characters or %u base64 characters",
+            is_32bit ? 4 : 8, is_32bit ? 8 : 16, is_32bit ? 8 : 12);
+        return;
+    }
+
+    // Compared as integers, in the same form hash() returns, so no result string is ever built
+    uint64_t stats_start = php_crc_fast_stats_start();
+    uint64_t result = is_custom
+        ? crc_fast_checksum_with_params(custom_params, data, data_len)
+        : php_crc_fast_reverse_bytes_if_needed(crc_fast_checksum(algo, data, data_len), algorithm);
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_VERIFY, algorithm, is_custom, data_len, stats_start);
+
+    RETURN_BOOL(result == expected);
+}
+/* }}} */
+
+/* {{{ CrcFast\verify_many(int|CrcFast\Params $algorithm, array $pairs): array */
+PHP_FUNCTION(CrcFast_verify_many)
+{
+    zval *algorithm_zval;
+    HashTable *pairs;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+        Z_PARAM_ZVAL(algorithm_zval)
+        Z_PARAM_ARRAY_HT(pairs)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    // Resolve everything once, up front, rather than per pair
+    CrcFastAlgorithm algo = CrcFastAlgorithm::Crc32IsoHdlc;
+    if (!is_custom) {
+        algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return; // Exception was thrown by get_algorithm
+        }
+    }
+
+    bool is_32bit = php_crc_fast_is_32bit(algorithm, is_custom, is_custom ? custom_params.width : 0);
+
+    array_init_size(return_value, zend_hash_num_elements(pairs));
+
+    uint32_t position = 0;
+    zend_ulong index;
+    zend_string *key;
+    zval *pair;
+    ZEND_HASH_FOREACH_KEY_VAL(pairs, index, key, pair) {
+        ZVAL_DEREF(pair);
+
+        zval *data = NULL, *expected_zval = NULL;
+        if (Z_TYPE_P(pair) == IS_ARRAY) {
+            data = zend_hash_index_find(Z_ARRVAL_P(pair), 0);
+            expected_zval = zend_hash_index_find(Z_ARRVAL_P(pair), 1);
+        }
+
+        if (data) {
+            ZVAL_DEREF(data);
+        }
+        if (expected_zval) {
+            ZVAL_DEREF(expected_zval);
+        }
+
+        if (!data || !expected_zval || Z_TYPE_P(data) != IS_STRING) {
+            zval_ptr_dtor(return_value);
+            ZVAL_NULL(return_value);
+            zend_throw_exception_ex(zend_ce_exception, 0,
+                "Pair %u must be an array of [string data, expected checksum]", position);
+            return;
+        }
+
+        uint64_t expected;
+        if (!php_crc_fast_parse_checksum(expected_zval, is_32bit, &expected)) {
+            zval_ptr_dtor(return_value);
+            ZVAL_NULL(return_value);
+            zend_throw_exception_ex(zend_ce_exception, 0,
+                "Pair %u has an invalid expected checksum, expected an int, %u binary bytes, %u hex characters or %u base64 characters",
+                position, is_32bit ? 4 : 8, is_32bit ? 8 : 16, is_32bit ? 8 : 12);
+            return;
+        }
+
+        uint64_t stats_start = php_crc_fast_stats_start();
+        uint64_t result = is_custom
+            ? crc_fast_checksum_with_params(custom_params, Z_STRVAL_P(data), Z_STRLEN_P(data))
+            : php_crc_fast_reverse_bytes_if_needed(crc_fast_checksum(algo, Z_STRVAL_P(data), Z_STRLEN_P(data)), algorithm);
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_VERIFY, algorithm, is_custom, Z_STRLEN_P(data), stats_start);
+
+        zval matches;
+        ZVAL_BOOL(&matches, result == expected);
+
+        // Preserve the input keys
+        if (key) {
+            zend_hash_update(Z_ARRVAL_P(return_value), key, &matches);
+        } else {
+            zend_hash_index_update(Z_ARRVAL_P(return_value), index, &matches);
+        }
+        position++;
+    } ZEND_HASH_FOREACH_END();
+}
+/* }}} */
+
+/* Helper function to (re)initialize a Digest object with an empty digest for the given algorithm */
+static bool php_crc_fast_digest_obj_init(php_crc_fast_digest_obj *obj, zend_long algorithm, bool is_custom, const CrcFastParams &custom_params)
+{
+    // Free previous digest if it exists
+    if (obj->digest) {
+        crc_fast_digest_free(obj->digest);
+        obj->digest = NULL;
+    }
+
+    obj->length = 0;
+    obj->prefix_checksum = 0;
+    obj->prefix_length = 0;
+
+    if (is_custom) {
+        // Use custom parameters - handle potential C library errors
+        try {
+            obj->digest = crc_fast_digest_new_with_params(custom_params);
+        } catch (...) {
+            zend_throw_exception(zend_ce_exception, "Failed to create digest with custom parameters", 0);
+            return false;
+        }
+        
+        if (!obj->digest) {
+            zend_throw_exception(zend_ce_exception, "C library failed to create digest with custom parameters", 0);
+            return false;
+        }
+        
+        obj->is_custom = true;
+        obj->custom_params = custom_params;
+        obj->algorithm = 0; // Not used for custom parameters
+
+        // Keep our own copy of the keys, since the Params object may go away before we do
+        memcpy(obj->custom_keys, custom_params.keys, sizeof(obj->custom_keys));
+        obj->custom_params.keys = obj->custom_keys;
+    } else {
+        // Use predefined algorithm - handle potential C library errors
+        CrcFastAlgorithm algo = php_crc_fast_get_algorithm(algorithm);
+        if (EG(exception)) {
+            return false; // Exception was thrown by get_algorithm
+        }
+        
+        try {
+            obj->digest = crc_fast_digest_new(algo);
+        } catch (...) {
+            zend_throw_exception_ex(zend_ce_exception, 0, 
+                "Failed to create digest for algorithm %lld", algorithm);
+            return false;
+        }
+        
+        if (!obj->digest) {
+            zend_throw_exception_ex(zend_ce_exception, 0, 
+                "C library failed to create digest for algorithm %lld", algorithm);
+            return false;
+        }
+        
+        obj->is_custom = false;
+        obj->algorithm = algorithm;
+        // Initialize custom_params to zero for safety
+        memset(&obj->custom_params, 0, sizeof(CrcFastParams));
+    }
+
+    return true;
+}
+
+/* Helper function to feed data into a Digest object, keeping track of the total length */
+static inline void php_crc_fast_digest_obj_update(php_crc_fast_digest_obj *obj, const char *data, size_t len)
+{
+    crc_fast_digest_update(obj->digest, data, len);
+    obj->length += len;
+}
+
+/* Helper function to combine two raw checksums using a Digest object's algorithm */
+static uint64_t php_crc_fast_digest_obj_combine(php_crc_fast_digest_obj *obj, uint64_t checksum1, uint64_t checksum2, uint64_t len2)
+{
+    if (obj->is_custom) {
+        return crc_fast_checksum_combine_with_params(obj->custom_params, checksum1, checksum2, len2);
+    }
+
+    return crc_fast_checksum_combine(php_crc_fast_get_algorithm(obj->algorithm), checksum1, checksum2, len2);
+}
+
+/* Helper function to get the raw checksum of everything fed into a Digest object so far, including any prefix */
+static uint64_t php_crc_fast_digest_obj_checksum(php_crc_fast_digest_obj *obj)
+{
+    if (obj->prefix_length == 0) {
+        return crc_fast_digest_finalize(obj->digest);
+    }
+
+    uint64_t live_length = obj->length - obj->prefix_length;
+    if (live_length == 0) {
+        return obj->prefix_checksum;
+    }
+
+    return php_crc_fast_digest_obj_combine(
+        obj, obj->prefix_checksum, crc_fast_digest_finalize(obj->digest), live_length);
+}
+
+/* Helper function to reset a Digest object back to its initial state */
+static void php_crc_fast_digest_obj_reset(php_crc_fast_digest_obj *obj)
+{
+    crc_fast_digest_reset(obj->digest);
+    obj->length = 0;
+    obj->prefix_checksum = 0;
+    obj->prefix_length = 0;
+}
+
+/* Helper function to return a Digest object's raw checksum in the requested format */
+static void php_crc_fast_digest_obj_return(INTERNAL_FUNCTION_PARAMETERS, php_crc_fast_digest_obj *obj, uint64_t result, zend_long format)
+{
+    if (obj->is_custom) {
+        // Use custom parameter formatting
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, format, true, obj->custom_params.width);
+    } else {
+        // Apply byte reversal if needed for predefined algorithms
+        result = php_crc_fast_reverse_bytes_if_needed(result, obj->algorithm);
+        // Format and return the result using predefined algorithm formatting
+        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj->algorithm, result, format);
+    }
+}
+
+/* {{{ CrcFast\Digest::__construct(int|CrcFast\Params $algorithm) */
+PHP_METHOD(CrcFast_Digest, __construct)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    zval *algorithm_zval;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_ZVAL(algorithm_zval)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!obj) {
+        zend_throw_exception(zend_ce_exception, "Failed to initialize Digest object", 0);
+        return;
+    }
+
+    zend_long algorithm;
+    CrcFastParams custom_params;
+    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
+    
+    if (EG(exception)) {
+        return; // Exception was thrown by helper function
+    }
+
+    php_crc_fast_digest_obj_init(obj, algorithm, is_custom, custom_params);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::update(string $data, int $offset = 0, ?int $length = null): void */
+PHP_METHOD(CrcFast_Digest, update)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    char *data;
+    size_t data_len;
+    zend_long offset = 0;
+    zend_long length = 0;
+    bool length_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(1, 3)
+        Z_PARAM_STRING(data, data_len)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_LONG(offset)
+        Z_PARAM_LONG_OR_NULL(length, length_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!obj) {
+        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+        return;
+    }
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    // Validate data parameter
+    if (!data) {
+        zend_throw_exception(zend_ce_exception, "Data parameter cannot be null", 0);
+        return;
+    }
+
+    if (!php_crc_fast_get_data_range(&data, &data_len, offset, length, length_is_null)) {
+        return;
+    }
+
+    // Handle potential C library errors
+    uint64_t stats_start = php_crc_fast_stats_start();
+    try {
+        php_crc_fast_digest_obj_update(obj, data, data_len);
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to update digest with data", 0);
+        return;
+    }
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_DIGEST, obj->algorithm, obj->is_custom, data_len, stats_start);
+
+    // Return $this for method chaining
+    RETURN_ZVAL(getThis(), 1, 0);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::updateStream(resource $stream, ?int $length = null, int $chunkSize = 1048576): int */
+PHP_METHOD(CrcFast_Digest, updateStream)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    zval *stream_zval;
+    zend_long length = 0;
+    bool length_is_null = 1;
+    zend_long chunk_size = PHP_CRC_FAST_DEFAULT_CHUNK_SIZE;
+    php_stream *stream;
+
+    ZEND_PARSE_PARAMETERS_START(1, 3)
+        Z_PARAM_RESOURCE(stream_zval)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_LONG_OR_NULL(length, length_is_null)
+        Z_PARAM_LONG(chunk_size)
+    ZEND_PARSE_PARAMETERS_END();
+
+    php_stream_from_zval(stream, stream_zval);
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    if (!length_is_null && length < 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Length must be non-negative, got %lld", length);
+        return;
+    }
+
+    if (chunk_size <= 0) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Chunk size must be positive, got %lld", chunk_size);
+        return;
+    }
+
+    uint64_t stats_start = php_crc_fast_stats_start();
+    size_t consumed;
+    bool success = php_crc_fast_digest_update_from_stream(
+        obj->digest, stream, (size_t)chunk_size, length_is_null ? SIZE_MAX : (size_t)length, &consumed);
+    obj->length += consumed;
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_DIGEST, obj->algorithm, obj->is_custom, consumed, stats_start);
+
+    if (!success) {
+        zend_throw_exception_ex(zend_ce_exception, 0,
+            "Failed to read from stream after %zu bytes", consumed);
+        return;
+    }
+
+    RETURN_LONG((zend_long)consumed);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::finalize(bool $binary = false, ?int $format = null): string|int */
+PHP_METHOD(CrcFast_Digest, finalize)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    if (!obj) {
+        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+        return;
+    }
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    uint64_t result;
+    try {
+        result = php_crc_fast_digest_obj_checksum(obj);
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to finalize digest", 0);
+        return;
+    }
+
+    php_crc_fast_digest_obj_return(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj, result, output_format);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::reset(): void */
+PHP_METHOD(CrcFast_Digest, reset)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    if (!obj) {
+        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+        return;
+    }
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    try {
+        php_crc_fast_digest_obj_reset(obj);
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to reset digest", 0);
+        return;
+    }
+
+    // Return $this for method chaining
+    RETURN_ZVAL(getThis(), 1, 0);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::finalizeReset(bool $binary = false, ?int $format = null): string|int */
+PHP_METHOD(CrcFast_Digest, finalizeReset)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
+        return;
+    }
+
+    if (!obj) {
+        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+        return;
+    }
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    uint64_t result;
+    try {
+        result = php_crc_fast_digest_obj_checksum(obj);
+        php_crc_fast_digest_obj_reset(obj);
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to finalize and reset digest", 0);
+        return;
+    }
+
+    php_crc_fast_digest_obj_return(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj, result, output_format);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::finalizeInt(): int */
+PHP_METHOD(CrcFast_Digest, finalizeInt)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    uint64_t result;
+    try {
+        result = php_crc_fast_digest_obj_checksum(obj);
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to finalize digest", 0);
+        return;
+    }
+
+    if (obj->is_custom) {
+        php_crc_fast_format_result_int(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, true, obj->custom_params.width);
+    } else {
+        result = php_crc_fast_reverse_bytes_if_needed(result, obj->algorithm);
+        php_crc_fast_format_result_int(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj->algorithm, result);
+    }
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::combine(CrcFast\Digest $other): void */
+PHP_METHOD(CrcFast_Digest, combine)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    zval *other_zval;
+    php_crc_fast_digest_obj *other_obj;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_OBJECT_OF_CLASS(other_zval, php_crc_fast_digest_ce)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!obj) {
+        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+        return;
+    }
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    other_obj = Z_CRC_FAST_DIGEST_P(other_zval);
+    if (!other_obj) {
+        zend_throw_exception(zend_ce_exception, "Invalid other Digest object", 0);
+        return;
+    }
+
+    if (!other_obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Other digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    try {
+        if (other_obj->prefix_length == 0) {
+            crc_fast_digest_combine(obj->digest, other_obj->digest);
+            obj->length += other_obj->length;
+        } else {
+            // The other digest was unserialized, so its native digest doesn't cover everything it has seen;
+            // fold both sides into our prefix instead
+            uint64_t checksum = php_crc_fast_digest_obj_combine(
+                obj, php_crc_fast_digest_obj_checksum(obj), php_crc_fast_digest_obj_checksum(other_obj), other_obj->length);
+            crc_fast_digest_reset(obj->digest);
+            obj->length += other_obj->length;
+            obj->prefix_checksum = checksum;
+            obj->prefix_length = obj->length;
+        }
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to combine digest objects", 0);
+        return;
+    }
+
+    // Return $this for method chaining
+    RETURN_ZVAL(getThis(), 1, 0);
+}
+/* }}} */
+
+/* {{{ CrcFast\Digest::__serialize(): array */
+PHP_METHOD(CrcFast_Digest, __serialize)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    if (!obj->digest) {
+        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+        return;
+    }
+
+    uint64_t checksum;
+    try {
+        checksum = php_crc_fast_digest_obj_checksum(obj);
+    } catch (...) {
+        zend_throw_exception(zend_ce_exception, "Failed to serialize digest", 0);
+        return;
+    }
+
+    // [version, algorithm or custom parameters, raw checksum so far, length so far]
+    array_init_size(return_value, 4);
+    add_next_index_long(return_value, PHP_CRC_FAST_DIGEST_SERIALIZE_VERSION);
+
+    if (obj->is_custom) {
+        zval params;
+        array_init_size(&params, 7);
+        add_next_index_long(&params, obj->custom_params.width);
+        add_next_index_long(&params, (zend_long)obj->custom_params.poly);
+        add_next_index_long(&params, (zend_long)obj->custom_params.init);
+        add_next_index_bool(&params, obj->custom_params.refin);
+        add_next_index_bool(&params, obj->custom_params.refout);
+        add_next_index_long(&params, (zend_long)obj->custom_params.xorout);
+        add_next_index_long(&params, (zend_long)obj->custom_params.check);
+        add_next_index_zval(return_value, &params);
+    } else {
+        add_next_index_long(return_value, obj->algorithm);
+    }
+
+    add_next_index_long(return_value, (zend_long)checksum);
+    add_next_index_long(return_value, (zend_long)obj->length);
+}
+/* }}} */
+
+static uint64_t *php_crc_fast_params_cache_get(const CrcFastParams &params, uint64_t *keys_out, uint64_t *check_out);
+
+/* Helper function to rebuild custom parameters from the array written by CrcFast\Digest::__serialize() */
+static bool php_crc_fast_digest_unserialize_params(HashTable *ht, CrcFastParams *params, uint64_t *keys)
+{
+    zval *values[7];
+
+    if (zend_hash_num_elements(ht) != 7) {
+        return false;
+    }
+
+    for (zend_ulong i = 0; i < 7; i++) {
+        values[i] = zend_hash_index_find(ht, i);
+        if (!values[i]) {
+            return false;
+        }
+
+        bool is_flag = (i == 3 || i == 4);
+        if (is_flag ? (Z_TYPE_P(values[i]) != IS_TRUE && Z_TYPE_P(values[i]) != IS_FALSE) : Z_TYPE_P(values[i]) != IS_LONG) {
+            return false;
+        }
+    }
+
+    zend_long width = Z_LVAL_P(values[0]);
+    if (width != 32 && width != 64) {
+        return false;
+    }
+
+    uint64_t poly = (uint64_t)Z_LVAL_P(values[1]);
+    uint64_t init = (uint64_t)Z_LVAL_P(values[2]);
+    bool refin = Z_TYPE_P(values[3]) == IS_TRUE;
+    bool refout = Z_TYPE_P(values[4]) == IS_TRUE;
+    uint64_t xorout = (uint64_t)Z_LVAL_P(values[5]);
+    uint64_t check = (uint64_t)Z_LVAL_P(values[6]);
+
+    if (width == 32 && ((poly | init | xorout | check) > 0xFFFFFFFFULL)) {
+        return false;
+    }
+
+    params->algorithm = (width == 32) ? CrcFastAlgorithm::Crc32Custom : CrcFastAlgorithm::Crc64Custom;
+    params->width = (uint8_t)width;
+    params->poly = poly;
+    params->init = init;
+    params->refin = refin;
+    params->refout = refout;
+    params->xorout = xorout;
+    params->check = check;
+    params->key_count = 23;
+
+    // Resumable uploads unserialize the same parameters over and over, so share the keys with CrcFast\Params
+    uint64_t computed_check;
+    uint64_t *shared_keys = php_crc_fast_params_cache_get(*params, keys, &computed_check);
+    params->keys = shared_keys ? shared_keys : keys;
+
+    // Same sanity check as CrcFast\Params, so tampered parameters can't produce a digest that lies
+    return computed_check == check;
+}
+
+/* {{{ CrcFast\Digest::__unserialize(array $data): void */
+PHP_METHOD(CrcFast_Digest, __unserialize)
+{
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    HashTable *data;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_ARRAY_HT(data)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zval *version = zend_hash_index_find(data, 0);
+    zval *algorithm_zval = zend_hash_index_find(data, 1);
+    zval *checksum = zend_hash_index_find(data, 2);
+    zval *length = zend_hash_index_find(data, 3);
+
+    if (!version || Z_TYPE_P(version) != IS_LONG || Z_LVAL_P(version) != PHP_CRC_FAST_DIGEST_SERIALIZE_VERSION
+        || !algorithm_zval || !checksum || Z_TYPE_P(checksum) != IS_LONG
+        || !length || Z_TYPE_P(length) != IS_LONG || Z_LVAL_P(length) < 0) {
+        zend_throw_exception(zend_ce_exception, "Invalid serialization data for CrcFast\\Digest object", 0);
+        return;
+    }
+
+    zend_long algorithm = 0;
+    bool is_custom = false;
+    CrcFastParams custom_params;
+    uint64_t custom_keys[23];
+    memset(&custom_params, 0, sizeof(CrcFastParams));
+
+    if (Z_TYPE_P(algorithm_zval) == IS_LONG) {
+        algorithm = Z_LVAL_P(algorithm_zval);
+    } else if (Z_TYPE_P(algorithm_zval) == IS_ARRAY
+        && php_crc_fast_digest_unserialize_params(Z_ARRVAL_P(algorithm_zval), &custom_params, custom_keys)) {
+        is_custom = true;
+    } else {
+        zend_throw_exception(zend_ce_exception, "Invalid serialization data for CrcFast\\Digest object", 0);
+        return;
+    }
 
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, algorithm, result, binary);
+    if (!php_crc_fast_digest_obj_init(obj, algorithm, is_custom, custom_params)) {
+        return; // Exception was thrown by helper function
+    }
+
+    uint64_t raw_checksum = (uint64_t)Z_LVAL_P(checksum);
+    if (php_crc_fast_is_32bit(obj->algorithm, obj->is_custom, obj->custom_params.width) && raw_checksum > 0xFFFFFFFFULL) {
+        zend_throw_exception(zend_ce_exception, "Invalid serialization data for CrcFast\\Digest object", 0);
+        return;
     }
+
+    // The native digest can't be seeded with a checksum, so it starts empty and the saved state becomes a prefix
+    // which is combined back in when finalizing
+    obj->length = (uint64_t)Z_LVAL_P(length);
+    obj->prefix_checksum = raw_checksum;
+    obj->prefix_length = obj->length;
 }
 /* }}} */
 
-/* {{{ CrcFast\Digest::__construct(int|CrcFast\Params $algorithm) */
-PHP_METHOD(CrcFast_Digest, __construct)
+/* Clone a Digest object, including the state of the digest so far */
+static zend_object *php_crc_fast_digest_clone_obj(zend_object *object)
 {
-    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
-    zval *algorithm_zval;
+    php_crc_fast_digest_obj *old_obj = php_crc_fast_digest_from_obj(object);
+    zend_object *new_object = php_crc_fast_digest_create_object(object->ce);
+    php_crc_fast_digest_obj *new_obj = php_crc_fast_digest_from_obj(new_object);
+
+    zend_objects_clone_members(new_object, object);
+
+    new_obj->algorithm = old_obj->algorithm;
+    new_obj->is_custom = old_obj->is_custom;
+    new_obj->custom_params = old_obj->custom_params;
+    new_obj->length = old_obj->length;
+    new_obj->prefix_checksum = old_obj->prefix_checksum;
+    new_obj->prefix_length = old_obj->prefix_length;
+    if (new_obj->is_custom) {
+        memcpy(new_obj->custom_keys, old_obj->custom_keys, sizeof(new_obj->custom_keys));
+        new_obj->custom_params.keys = new_obj->custom_keys;
+    }
 
-    ZEND_PARSE_PARAMETERS_START(1, 1)
-        Z_PARAM_ZVAL(algorithm_zval)
-    ZEND_PARSE_PARAMETERS_END();
+    if (!old_obj->digest) {
+        return new_object;
+    }
 
-    if (!obj) {
-        zend_throw_exception(zend_ce_exception, "Failed to initialize Digest object", 0);
-        return;
+    if (new_obj->is_custom) {
+        new_obj->digest = crc_fast_digest_new_with_params(new_obj->custom_params);
+    } else {
+        new_obj->digest = crc_fast_digest_new(php_crc_fast_get_algorithm(new_obj->algorithm));
     }
 
-    // Free previous digest if it exists
-    if (obj->digest) {
-        crc_fast_digest_free(obj->digest);
-        obj->digest = NULL;
+    if (!new_obj->digest) {
+        zend_throw_exception(zend_ce_exception, "C library failed to create digest for clone", 0);
+        return new_object;
     }
 
-    zend_long algorithm;
-    CrcFastParams custom_params;
-    bool is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &algorithm, &custom_params);
-    
-    if (EG(exception)) {
-        return; // Exception was thrown by helper function
+    // Combining the original into an empty digest leaves us with an identical copy of its state (checksum
+    // and length so far), without needing to rehash anything
+    crc_fast_digest_combine(new_obj->digest, old_obj->digest);
+
+    return new_object;
+}
+
+/* Helper function to set up a digest for each of the algorithms given to CrcFast\hash_multi() or CrcFast\MultiDigest */
+static php_crc_fast_multi_entry *php_crc_fast_multi_entries_new(HashTable *algorithms)
+{
+    uint32_t count = zend_hash_num_elements(algorithms);
+
+    if (count == 0) {
+        zend_throw_exception(zend_ce_exception, "Algorithms array cannot be empty", 0);
+        return NULL;
     }
 
-    if (is_custom) {
-        // Use custom parameters - handle potential C library errors
-        try {
-            obj->digest = crc_fast_digest_new_with_params(custom_params);
-        } catch (...) {
-            zend_throw_exception(zend_ce_exception, "Failed to create digest with custom parameters", 0);
-            return;
+    php_crc_fast_multi_entry *entries = (php_crc_fast_multi_entry*)ecalloc(count, sizeof(php_crc_fast_multi_entry));
+    uint32_t i = 0;
+    zval *algorithm_zval;
+
+    ZEND_HASH_FOREACH_VAL(algorithms, algorithm_zval) {
+        php_crc_fast_multi_entry *entry = &entries[i++];
+
+        ZVAL_DEREF(algorithm_zval);
+        entry->is_custom = php_crc_fast_get_params_from_zval(algorithm_zval, &entry->algorithm, &entry->custom_params);
+        if (EG(exception)) {
+            break; // Exception was thrown by helper function
         }
-        
-        if (!obj->digest) {
-            zend_throw_exception(zend_ce_exception, "C library failed to create digest with custom parameters", 0);
-            return;
+
+        if (entry->is_custom) {
+            entry->digest = crc_fast_digest_new_with_params(entry->custom_params);
+        } else {
+            CrcFastAlgorithm algo = php_crc_fast_get_algorithm(entry->algorithm);
+            if (EG(exception)) {
+                break; // Exception was thrown by get_algorithm
+            }
+
+            entry->digest = crc_fast_digest_new(algo);
         }
-        
-        obj->is_custom = true;
-        obj->custom_params = custom_params;
-        obj->algorithm = 0; // Not used for custom parameters
-    } else {
-        // Use predefined algorithm - handle potential C library errors
-        CrcFastAlgorithm algo = php_crc_fast_get_algorithm(algorithm);
-        if (EG(exception)) {
-            return; // Exception was thrown by get_algorithm
+
+        if (!entry->digest) {
+            zend_throw_exception(zend_ce_exception, "C library failed to create digest", 0);
+            break;
         }
-        
-        try {
-            obj->digest = crc_fast_digest_new(algo);
-        } catch (...) {
-            zend_throw_exception_ex(zend_ce_exception, 0, 
-                "Failed to create digest for algorithm %lld", algorithm);
-            return;
+    } ZEND_HASH_FOREACH_END();
+
+    if (EG(exception)) {
+        php_crc_fast_multi_entries_free(entries, count);
+        return NULL;
+    }
+
+    return entries;
+}
+
+/* Helper function to feed data to every digest, a cache-sized chunk at a time, so large inputs are only
+ * streamed from memory once no matter how many algorithms are being calculated */
+static void php_crc_fast_multi_entries_update(php_crc_fast_multi_entry *entries, uint32_t count, const char *data, size_t data_len)
+{
+    // Every algorithm sees every chunk, so they're timed together and the time is split evenly between them
+    uint64_t stats_start = php_crc_fast_stats_start();
+    size_t stats_bytes = data_len;
+
+    while (data_len > 0) {
+        size_t chunk = MIN(data_len, (size_t)PHP_CRC_FAST_MULTI_CHUNK_SIZE);
+
+        for (uint32_t i = 0; i < count; i++) {
+            crc_fast_digest_update(entries[i].digest, data, chunk);
         }
-        
-        if (!obj->digest) {
-            zend_throw_exception_ex(zend_ce_exception, 0, 
-                "C library failed to create digest for algorithm %lld", algorithm);
+
+        data += chunk;
+        data_len -= chunk;
+    }
+
+    if (UNEXPECTED(php_crc_fast_stats_enabled) && count > 0) {
+        uint64_t ns = stats_start ? (php_crc_fast_stats_now() - stats_start) / count : 0;
+        for (uint32_t i = 0; i < count; i++) {
+            php_crc_fast_stats_record_ns(
+                PHP_CRC_FAST_STATS_HASH_MULTI, entries[i].algorithm, entries[i].is_custom, stats_bytes, ns);
+        }
+    }
+}
+
+/* Helper function to return every digest's checksum, keyed like the algorithms array */
+static void php_crc_fast_multi_entries_finalize(
+    INTERNAL_FUNCTION_PARAMETERS,
+    php_crc_fast_multi_entry *entries,
+    HashTable *algorithms,
+    zend_long format,
+    bool reset)
+{
+    uint32_t count = zend_hash_num_elements(algorithms);
+
+    // Check every width before finalizing anything, so finalizeReset() doesn't lose state when it throws
+    for (uint32_t i = 0; i < count; i++) {
+        bool is_32bit = entries[i].is_custom
+            ? php_crc_fast_is_32bit(0, true, entries[i].custom_params.width)
+            : php_crc_fast_is_32bit(entries[i].algorithm);
+        if (!php_crc_fast_check_format(format, is_32bit)) {
             return;
         }
-        
-        obj->is_custom = false;
-        obj->algorithm = algorithm;
-        // Initialize custom_params to zero for safety
-        memset(&obj->custom_params, 0, sizeof(CrcFastParams));
     }
+
+    array_init_size(return_value, count);
+
+    uint32_t i = 0;
+    zend_ulong index;
+    zend_string *key;
+    ZEND_HASH_FOREACH_KEY(algorithms, index, key) {
+        php_crc_fast_multi_entry *entry = &entries[i++];
+
+        uint64_t result = reset
+            ? crc_fast_digest_finalize_reset(entry->digest)
+            : crc_fast_digest_finalize(entry->digest);
+
+        bool is_32bit;
+        if (entry->is_custom) {
+            is_32bit = php_crc_fast_is_32bit(0, true, entry->custom_params.width);
+        } else {
+            // Apply byte reversal if needed for predefined algorithms
+            result = php_crc_fast_reverse_bytes_if_needed(result, entry->algorithm);
+            is_32bit = php_crc_fast_is_32bit(entry->algorithm);
+        }
+
+        zval checksum;
+        php_crc_fast_result_to_zval(&checksum, result, is_32bit, format);
+
+        if (key) {
+            zend_hash_update(Z_ARRVAL_P(return_value), key, &checksum);
+        } else {
+            zend_hash_index_update(Z_ARRVAL_P(return_value), index, &checksum);
+        }
+    } ZEND_HASH_FOREACH_END();
 }
-/* }}} */
 
-/* {{{ CrcFast\Digest::update(string $data): void */
-PHP_METHOD(CrcFast_Digest, update)
+/* {{{ CrcFast\hash_multi(array $algorithms, string $data, bool $binary = false, ?int $format = null): array */
+PHP_FUNCTION(CrcFast_hash_multi)
 {
-    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    HashTable *algorithms;
     char *data;
     size_t data_len;
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
 
-    ZEND_PARSE_PARAMETERS_START(1, 1)
+    ZEND_PARSE_PARAMETERS_START(2, 4)
+        Z_PARAM_ARRAY_HT(algorithms)
         Z_PARAM_STRING(data, data_len)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
     ZEND_PARSE_PARAMETERS_END();
 
-    if (!obj) {
-        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
         return;
     }
 
-    if (!obj->digest) {
-        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
-        return;
+    php_crc_fast_multi_entry *entries = php_crc_fast_multi_entries_new(algorithms);
+    if (!entries) {
+        return; // Exception was thrown by helper function
     }
 
-    // Validate data parameter
-    if (!data) {
-        zend_throw_exception(zend_ce_exception, "Data parameter cannot be null", 0);
-        return;
+    uint32_t count = zend_hash_num_elements(algorithms);
+
+    php_crc_fast_multi_entries_update(entries, count, data, data_len);
+    php_crc_fast_multi_entries_finalize(INTERNAL_FUNCTION_PARAM_PASSTHRU, entries, algorithms, output_format, false);
+
+    php_crc_fast_multi_entries_free(entries, count);
+}
+/* }}} */
+
+/* {{{ CrcFast\MultiDigest::__construct(array $algorithms) */
+PHP_METHOD(CrcFast_MultiDigest, __construct)
+{
+    php_crc_fast_multi_digest_obj *obj = Z_CRC_FAST_MULTI_DIGEST_P(getThis());
+    HashTable *algorithms;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_ARRAY_HT(algorithms)
+    ZEND_PARSE_PARAMETERS_END();
+
+    // Free previous digests if they exist
+    if (obj->entries) {
+        php_crc_fast_multi_entries_free(obj->entries, obj->count);
+        obj->entries = NULL;
+        obj->count = 0;
     }
+    zval_ptr_dtor(&obj->algorithms);
+    ZVAL_UNDEF(&obj->algorithms);
 
-    // Handle potential C library errors
-    try {
-        crc_fast_digest_update(obj->digest, data, data_len);
-    } catch (...) {
-        zend_throw_exception(zend_ce_exception, "Failed to update digest with data", 0);
+    php_crc_fast_multi_entry *entries = php_crc_fast_multi_entries_new(algorithms);
+    if (!entries) {
+        return; // Exception was thrown by helper function
+    }
+
+    obj->entries = entries;
+    obj->count = zend_hash_num_elements(algorithms);
+    ZVAL_ARR(&obj->algorithms, zend_array_dup(algorithms));
+}
+/* }}} */
+
+/* {{{ CrcFast\MultiDigest::update(string $data): MultiDigest */
+PHP_METHOD(CrcFast_MultiDigest, update)
+{
+    php_crc_fast_multi_digest_obj *obj = Z_CRC_FAST_MULTI_DIGEST_P(getThis());
+    char *data;
+    size_t data_len;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_STRING(data, data_len)
+    ZEND_PARSE_PARAMETERS_END();
+
+    if (!obj->entries) {
+        zend_throw_exception(zend_ce_exception, "MultiDigest object not initialized. Call constructor first", 0);
         return;
     }
 
+    php_crc_fast_multi_entries_update(obj->entries, obj->count, data, data_len);
+
     // Return $this for method chaining
     RETURN_ZVAL(getThis(), 1, 0);
 }
 /* }}} */
 
-/* {{{ CrcFast\Digest::finalize(bool $binary = false): string */
-PHP_METHOD(CrcFast_Digest, finalize)
+/* {{{ CrcFast\MultiDigest::finalize(bool $binary = false, ?int $format = null): array */
+PHP_METHOD(CrcFast_MultiDigest, finalize)
 {
-    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    php_crc_fast_multi_digest_obj *obj = Z_CRC_FAST_MULTI_DIGEST_P(getThis());
     zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
 
-    ZEND_PARSE_PARAMETERS_START(0, 1)
+    ZEND_PARSE_PARAMETERS_START(0, 2)
         Z_PARAM_OPTIONAL
         Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
     ZEND_PARSE_PARAMETERS_END();
 
-    if (!obj) {
-        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
         return;
     }
 
-    if (!obj->digest) {
-        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+    if (!obj->entries) {
+        zend_throw_exception(zend_ce_exception, "MultiDigest object not initialized. Call constructor first", 0);
         return;
     }
 
-    uint64_t result;
-    try {
-        result = crc_fast_digest_finalize(obj->digest);
-    } catch (...) {
-        zend_throw_exception(zend_ce_exception, "Failed to finalize digest", 0);
+    php_crc_fast_multi_entries_finalize(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj->entries, Z_ARRVAL(obj->algorithms), output_format, false);
+}
+/* }}} */
+
+/* {{{ CrcFast\MultiDigest::finalizeReset(bool $binary = false, ?int $format = null): array */
+PHP_METHOD(CrcFast_MultiDigest, finalizeReset)
+{
+    php_crc_fast_multi_digest_obj *obj = Z_CRC_FAST_MULTI_DIGEST_P(getThis());
+    zend_bool binary = 0;
+    zend_long format = 0;
+    bool format_is_null = 1;
+
+    ZEND_PARSE_PARAMETERS_START(0, 2)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(binary)
+        Z_PARAM_LONG_OR_NULL(format, format_is_null)
+    ZEND_PARSE_PARAMETERS_END();
+
+    zend_long output_format;
+    if (!php_crc_fast_get_format(binary, format, format_is_null, &output_format)) {
         return;
     }
 
-    if (obj->is_custom) {
-        // Use custom parameter formatting
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, binary, true, obj->custom_params.width);
-    } else {
-        // Apply byte reversal if needed for predefined algorithms
-        result = php_crc_fast_reverse_bytes_if_needed(result, obj->algorithm);
-        // Format and return the result using predefined algorithm formatting
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj->algorithm, result, binary);
+    if (!obj->entries) {
+        zend_throw_exception(zend_ce_exception, "MultiDigest object not initialized. Call constructor first", 0);
+        return;
     }
+
+    php_crc_fast_multi_entries_finalize(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj->entries, Z_ARRVAL(obj->algorithms), output_format, true);
 }
 /* }}} */
 
-/* {{{ CrcFast\Digest::reset(): void */
-PHP_METHOD(CrcFast_Digest, reset)
+/* {{{ CrcFast\MultiDigest::reset(): MultiDigest */
+PHP_METHOD(CrcFast_MultiDigest, reset)
 {
-    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
+    php_crc_fast_multi_digest_obj *obj = Z_CRC_FAST_MULTI_DIGEST_P(getThis());
 
     ZEND_PARSE_PARAMETERS_NONE();
 
-    if (!obj) {
-        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
-        return;
-    }
-
-    if (!obj->digest) {
-        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
+    if (!obj->entries) {
+        zend_throw_exception(zend_ce_exception, "MultiDigest object not initialized. Call constructor first", 0);
         return;
     }
 
-    try {
-        crc_fast_digest_reset(obj->digest);
-    } catch (...) {
-        zend_throw_exception(zend_ce_exception, "Failed to reset digest", 0);
-        return;
+    for (uint32_t i = 0; i < obj->count; i++) {
+        crc_fast_digest_reset(obj->entries[i].digest);
     }
 
     // Return $this for method chaining
@@ -790,87 +4767,196 @@ PHP_METHOD(CrcFast_Digest, reset)
 }
 /* }}} */
 
-/* {{{ CrcFast\Digest::finalizeReset(bool $binary = false): string */
-PHP_METHOD(CrcFast_Digest, finalizeReset)
-{
-    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
-    zend_bool binary = 0;
-
-    ZEND_PARSE_PARAMETERS_START(0, 1)
-        Z_PARAM_OPTIONAL
-        Z_PARAM_BOOL(binary)
-    ZEND_PARSE_PARAMETERS_END();
+/* Process-wide cache of generated keys and check values for custom parameters
+ *
+ * Entries are never evicted (only cleared at MSHUTDOWN), so Params objects can point at the cached keys
+ * directly. The cache is bounded, and shared between threads under ZTS.
+ */
+struct php_crc_fast_params_cache_key {
+    uint8_t width;
+    uint64_t poly;
+    uint64_t init;
+    bool refin;
+    bool refout;
+    uint64_t xorout;
+
+    bool operator==(const php_crc_fast_params_cache_key &other) const {
+        return width == other.width && poly == other.poly && init == other.init
+            && refin == other.refin && refout == other.refout && xorout == other.xorout;
+    }
+};
 
-    if (!obj) {
-        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
-        return;
+struct php_crc_fast_params_cache_key_hash {
+    size_t operator()(const php_crc_fast_params_cache_key &key) const {
+        uint64_t h = key.poly;
+        h = h * 31 + key.init;
+        h = h * 31 + key.xorout;
+        h = h * 31 + ((uint64_t)key.width << 2 | (uint64_t)key.refin << 1 | (uint64_t)key.refout);
+        return std::hash<uint64_t>()(h);
     }
+};
 
-    if (!obj->digest) {
-        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
-        return;
+struct php_crc_fast_params_cache_entry {
+    uint64_t keys[23];
+    uint64_t check;  // Computed checksum of "123456789"
+};
+
+static std::unordered_map<php_crc_fast_params_cache_key, php_crc_fast_params_cache_entry, php_crc_fast_params_cache_key_hash> php_crc_fast_params_cache;
+static std::mutex php_crc_fast_params_cache_mutex;
+static std::atomic<uint64_t> php_crc_fast_params_cache_hits(0);
+static std::atomic<uint64_t> php_crc_fast_params_cache_misses(0);
+
+/* Helper function to get the generated keys and computed check value for custom parameters
+ *
+ * Returns the shared, cached keys, or NULL if the cache is full, in which case the keys are written to keys_out.
+ */
+static uint64_t *php_crc_fast_params_cache_get(const CrcFastParams &params, uint64_t *keys_out, uint64_t *check_out)
+{
+    php_crc_fast_params_cache_key key = {params.width, params.poly, params.init, params.refin, params.refout, params.xorout};
+
+    {
+        std::lock_guard<std::mutex> lock(php_crc_fast_params_cache_mutex);
+        auto it = php_crc_fast_params_cache.find(key);
+        if (it != php_crc_fast_params_cache.end()) {
+            php_crc_fast_params_cache_hits++;
+            *check_out = it->second.check;
+            return it->second.keys;
+        }
     }
 
-    uint64_t result;
-    try {
-        result = crc_fast_digest_finalize_reset(obj->digest);
-    } catch (...) {
-        zend_throw_exception(zend_ce_exception, "Failed to finalize and reset digest", 0);
-        return;
+    php_crc_fast_params_cache_misses++;
+
+    // Generated without the lock, so other threads' lookups don't wait on it
+    CrcFastParams generated = crc_fast_get_custom_params(
+        "", // name is not used for key generation
+        params.width,
+        params.poly,
+        params.init,
+        params.refin,
+        params.xorout,
+        params.check
+    );
+
+    php_crc_fast_params_cache_entry entry;
+    memcpy(entry.keys, generated.keys, sizeof(entry.keys));
+
+    CrcFastParams validated = params;
+    validated.key_count = 23;
+    validated.keys = entry.keys;
+    entry.check = crc_fast_checksum_with_params(validated, "123456789", 9);
+    *check_out = entry.check;
+
+    std::lock_guard<std::mutex> lock(php_crc_fast_params_cache_mutex);
+    if (php_crc_fast_params_cache.size() >= PHP_CRC_FAST_PARAMS_CACHE_MAX_ENTRIES
+        && php_crc_fast_params_cache.find(key) == php_crc_fast_params_cache.end()) {
+        memcpy(keys_out, entry.keys, sizeof(entry.keys));
+        return NULL;
     }
 
-    if (obj->is_custom) {
-        // Use custom parameter formatting
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, 0, result, binary, true, obj->custom_params.width);
-    } else {
-        // Apply byte reversal if needed for predefined algorithms
-        result = php_crc_fast_reverse_bytes_if_needed(result, obj->algorithm);
-        php_crc_fast_format_result(INTERNAL_FUNCTION_PARAM_PASSTHRU, obj->algorithm, result, binary);
+    // Another thread may have inserted the same parameters meanwhile, in which case theirs is kept
+    return php_crc_fast_params_cache.emplace(key, entry).first->second.keys;
+}
+
+/* {{{ CrcFast\get_params_cache_stats(): array */
+PHP_FUNCTION(CrcFast_get_params_cache_stats)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    size_t entries;
+    {
+        std::lock_guard<std::mutex> lock(php_crc_fast_params_cache_mutex);
+        entries = php_crc_fast_params_cache.size();
     }
+
+    array_init_size(return_value, 3);
+    add_assoc_long(return_value, "hits", (zend_long)php_crc_fast_params_cache_hits.load());
+    add_assoc_long(return_value, "misses", (zend_long)php_crc_fast_params_cache_misses.load());
+    add_assoc_long(return_value, "entries", (zend_long)entries);
 }
 /* }}} */
 
-/* {{{ CrcFast\Digest::combine(CrcFast\Digest $other): void */
-PHP_METHOD(CrcFast_Digest, combine)
+/* Helper function to name an algorithm slot of the stats counters */
+static inline const char *php_crc_fast_stats_algorithm_name(size_t index)
 {
-    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(getThis());
-    zval *other_zval;
-    php_crc_fast_digest_obj *other_obj;
+    return index == PHP_CRC_FAST_STATS_CUSTOM ? "custom" : php_crc_fast_algorithms[index].name;
+}
 
-    ZEND_PARSE_PARAMETERS_START(1, 1)
-        Z_PARAM_OBJECT_OF_CLASS(other_zval, php_crc_fast_digest_ce)
-    ZEND_PARSE_PARAMETERS_END();
+/* Helper function to get the smallest size counted by a histogram bucket */
+static inline uint64_t php_crc_fast_stats_bucket_min(size_t bucket)
+{
+    return bucket == 0 ? 0 : (uint64_t)1 << (bucket - 1);
+}
+
+/* {{{ CrcFast\get_stats(): array */
+PHP_FUNCTION(CrcFast_get_stats)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    php_crc_fast_stats_totals totals;
+    php_crc_fast_stats_collect(&totals);
+
+    uint64_t calls = 0, bytes = 0, ns = 0;
+    zval algorithms;
+    array_init(&algorithms);
+
+    for (size_t a = 0; a < PHP_CRC_FAST_STATS_ALGORITHM_COUNT; a++) {
+        zval entries;
+        ZVAL_UNDEF(&entries);
+
+        for (size_t e = 0; e < PHP_CRC_FAST_STATS_ENTRY_COUNT; e++) {
+            const uint64_t *counter = totals.counters[a][e];
+            if (counter[0] == 0) {
+                continue;
+            }
+
+            if (Z_ISUNDEF(entries)) {
+                array_init(&entries);
+            }
+
+            zval entry;
+            array_init_size(&entry, 3);
+            add_assoc_long(&entry, "calls", (zend_long)counter[0]);
+            add_assoc_long(&entry, "bytes", (zend_long)counter[1]);
+            add_assoc_long(&entry, "ns", (zend_long)counter[2]);
+            add_assoc_zval(&entries, php_crc_fast_stats_entry_names[e], &entry);
+
+            calls += counter[0];
+            bytes += counter[1];
+            ns += counter[2];
+        }
 
-    if (!obj) {
-        zend_throw_exception(zend_ce_exception, "Invalid Digest object", 0);
-        return;
+        if (!Z_ISUNDEF(entries)) {
+            add_assoc_zval(&algorithms, php_crc_fast_stats_algorithm_name(a), &entries);
+        }
     }
 
-    if (!obj->digest) {
-        zend_throw_exception(zend_ce_exception, "Digest object not initialized. Call constructor first", 0);
-        return;
+    // Keyed by the smallest size each bucket counts, up to the next key
+    zval histogram;
+    array_init_size(&histogram, PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS);
+    for (size_t b = 0; b < PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS; b++) {
+        add_index_long(&histogram, (zend_ulong)php_crc_fast_stats_bucket_min(b), (zend_long)totals.histogram[b]);
     }
 
-    other_obj = Z_CRC_FAST_DIGEST_P(other_zval);
-    if (!other_obj) {
-        zend_throw_exception(zend_ce_exception, "Invalid other Digest object", 0);
-        return;
-    }
+    array_init_size(return_value, 7);
+    add_assoc_bool(return_value, "enabled", php_crc_fast_stats_enabled);
+    add_assoc_bool(return_value, "timing", php_crc_fast_stats_timing);
+    add_assoc_long(return_value, "calls", (zend_long)calls);
+    add_assoc_long(return_value, "bytes", (zend_long)bytes);
+    add_assoc_long(return_value, "ns", (zend_long)ns);
+    add_assoc_zval(return_value, "algorithms", &algorithms);
+    add_assoc_zval(return_value, "histogram", &histogram);
+}
+/* }}} */
 
-    if (!other_obj->digest) {
-        zend_throw_exception(zend_ce_exception, "Other digest object not initialized. Call constructor first", 0);
-        return;
-    }
+/* {{{ CrcFast\reset_stats(): void */
+PHP_FUNCTION(CrcFast_reset_stats)
+{
+    ZEND_PARSE_PARAMETERS_NONE();
 
-    try {
-        crc_fast_digest_combine(obj->digest, other_obj->digest);
-    } catch (...) {
-        zend_throw_exception(zend_ce_exception, "Failed to combine digest objects", 0);
-        return;
-    }
+    std::lock_guard<std::mutex> lock(php_crc_fast_stats_mutex);
 
-    // Return $this for method chaining
-    RETURN_ZVAL(getThis(), 1, 0);
+    php_crc_fast_stats_baseline = {};
+    php_crc_fast_stats_add_all(&php_crc_fast_stats_baseline);
 }
 /* }}} */
 
@@ -968,10 +5054,15 @@ PHP_METHOD(CrcFast_Params, __construct)
     obj->params.xorout = (uint64_t)xorout;
     obj->params.check = (uint64_t)check;
 
-    // Allocate memory for keys array (23 elements)
-    obj->keys_storage = (uint64_t*)emalloc(23 * sizeof(uint64_t));
     obj->params.key_count = 23;
-    obj->params.keys = obj->keys_storage;
+
+    obj->params.keys = NULL;
+    if (obj->keys_storage) {
+        efree(obj->keys_storage);
+        obj->keys_storage = NULL;
+    }
+
+    uint64_t computed_check;
 
     // Handle keys parameter
     if (keys_array && Z_TYPE_P(keys_array) == IS_ARRAY) {
@@ -983,6 +5074,10 @@ PHP_METHOD(CrcFast_Params, __construct)
             return;
         }
 
+        // Allocate memory for keys array (23 elements)
+        obj->keys_storage = (uint64_t*)emalloc(23 * sizeof(uint64_t));
+        obj->params.keys = obj->keys_storage;
+
         // Copy keys from PHP array to C array
         zval *key_val;
         int i = 0;
@@ -1003,40 +5098,37 @@ PHP_METHOD(CrcFast_Params, __construct)
             obj->keys_storage[i] = (uint64_t)key_value;
             i++;
         } ZEND_HASH_FOREACH_END();
+
+        // Validate the parameters by checking if they produce the expected check value
+        // This is done by computing CRC of "123456789" and comparing with check parameter
+        try {
+            computed_check = crc_fast_checksum_with_params(obj->params, "123456789", 9);
+        } catch (...) {
+            zend_throw_exception(zend_ce_exception, "Failed to validate custom CRC parameters", 0);
+            return;
+        }
     } else {
-        // Generate keys using the C library helper function - handle potential errors
-        CrcFastParams temp_params;
+        // Generated keys (and the check value they produce) only depend on the parameters, so they're
+        // shared with every other Params object using the same ones
+        uint64_t keys[23];
+        uint64_t *shared_keys;
         try {
-            temp_params = crc_fast_get_custom_params(
-                "", // name is not used for key generation
-                (uint8_t)width,
-                (uint64_t)poly,
-                (uint64_t)init,
-                refin,
-                (uint64_t)xorout,
-                (uint64_t)check
-            );
+            shared_keys = php_crc_fast_params_cache_get(obj->params, keys, &computed_check);
         } catch (...) {
             zend_throw_exception(zend_ce_exception, "Failed to generate keys for custom CRC parameters", 0);
             return;
         }
-        
-        // Copy the generated keys
-        memcpy(obj->keys_storage, temp_params.keys, 23 * sizeof(uint64_t));
-    }
 
-    // Validate the parameters by checking if they produce the expected check value
-    // This is done by computing CRC of "123456789" and comparing with check parameter
-    const char *test_data = "123456789";
-    uint64_t computed_check;
-    
-    try {
-        computed_check = crc_fast_checksum_with_params(obj->params, test_data, 9);
-    } catch (...) {
-        zend_throw_exception(zend_ce_exception, "Failed to validate custom CRC parameters", 0);
-        return;
+        if (shared_keys) {
+            obj->params.keys = shared_keys;
+        } else {
+            // The cache is full, so keep our own copy
+            obj->keys_storage = (uint64_t*)emalloc(23 * sizeof(uint64_t));
+            memcpy(obj->keys_storage, keys, 23 * sizeof(uint64_t));
+            obj->params.keys = obj->keys_storage;
+        }
     }
-    
+
     if (computed_check != (uint64_t)check) {
         zend_throw_exception_ex(zend_ce_exception, 0, 
             "Parameters validation failed: computed check 0x%016" PRIx64 " does not match expected check 0x%016" PRIx64 ". "
@@ -1180,6 +5272,322 @@ PHP_METHOD(CrcFast_Params, getKeys)
 }
 /* }}} */
 
+/* ext/hash backends
+ *
+ * ext/hash allocates and frees contexts itself (with efree(), and without a destructor hook), so the
+ * context can't own a CrcFastDigestHandle. Instead it carries the running checksum and the input
+ * length, which keeps the context plain memory that ext/hash can copy and (un)serialize for us.
+ *
+ * hash_file() and hash_update_stream() feed small buffers, so each update carries on from the running
+ * checksum, passing its un-xored register as the init of the algorithm's own parameters, rather than
+ * paying for a combine per buffer. Whether the library takes that register as-is or bit-reversed for
+ * reflected algorithms is worked out at MINIT against the check string, falling back to combining for
+ * any algorithm where neither works. */
+enum php_crc_fast_hash_resume_mode {
+    PHP_CRC_FAST_HASH_RESUME_COMBINE,    // Checksum each update on its own and combine it in
+    PHP_CRC_FAST_HASH_RESUME_REGISTER,   // Pass the register as init
+    PHP_CRC_FAST_HASH_RESUME_REFLECTED,  // Pass the register bit-reversed as init
+};
+
+typedef struct _php_crc_fast_hash_resume {
+    php_crc_fast_hash_resume_mode mode;
+    CrcFastParams params;  // The algorithm's own parameters, whose init is replaced on each update
+    uint64_t keys[23];  // Storage for params.keys
+} php_crc_fast_hash_resume;
+
+/* Indexed like php_crc_fast_algorithms, set up at MINIT and read-only afterwards */
+static php_crc_fast_hash_resume php_crc_fast_hash_resumes[PHP_CRC_FAST_ALGORITHM_COUNT];
+
+static inline uint64_t php_crc_fast_reflect(uint64_t value, uint8_t width)
+{
+    uint64_t reflected = 0;
+    for (uint8_t i = 0; i < width; i++) {
+        reflected = (reflected << 1) | ((value >> i) & 1);
+    }
+
+    return reflected;
+}
+
+/* Helper function to checksum more data following a checksum of what came before */
+static inline uint64_t php_crc_fast_hash_resume_checksum(
+    const php_crc_fast_hash_resume *resume, uint64_t checksum, const char *data, size_t data_len)
+{
+    CrcFastParams params = resume->params;
+    params.init = checksum ^ params.xorout;
+    if (resume->mode == PHP_CRC_FAST_HASH_RESUME_REFLECTED) {
+        params.init = php_crc_fast_reflect(params.init, params.width);
+    }
+
+    return crc_fast_checksum_with_params(params, data, data_len);
+}
+
+/* Helper function to check a resume mode gives the same checksums of the check string, however it's split */
+static bool php_crc_fast_hash_resume_works(const php_crc_fast_algorithm_info *info, const php_crc_fast_hash_resume *resume)
+{
+    uint64_t expected = crc_fast_checksum(info->algorithm, "123456789", 9);
+
+    for (size_t split = 1; split < 9; split += 3) {
+        uint64_t checksum = crc_fast_checksum(info->algorithm, "123456789", split);
+        if (php_crc_fast_hash_resume_checksum(resume, checksum, "123456789" + split, 9 - split) != expected) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Helper function to work out how each ext/hash backend resumes, at MINIT */
+static void php_crc_fast_hash_resume_init(void)
+{
+    for (size_t i = 0; i < PHP_CRC_FAST_ALGORITHM_COUNT; i++) {
+        const php_crc_fast_algorithm_info *info = &php_crc_fast_algorithms[i];
+        php_crc_fast_hash_resume *resume = &php_crc_fast_hash_resumes[i];
+
+        CrcFastParams generated = crc_fast_get_custom_params(
+            "", info->width, info->poly, info->init, info->refin, info->xorout, info->check);
+        memcpy(resume->keys, generated.keys, sizeof(resume->keys));
+
+        resume->params = generated;
+        resume->params.algorithm = (info->width == 32) ? CrcFastAlgorithm::Crc32Custom : CrcFastAlgorithm::Crc64Custom;
+        resume->params.refout = info->refout;
+        resume->params.key_count = 23;
+        resume->params.keys = resume->keys;
+
+        resume->mode = PHP_CRC_FAST_HASH_RESUME_REGISTER;
+        if (php_crc_fast_hash_resume_works(info, resume)) {
+            continue;
+        }
+
+        resume->mode = PHP_CRC_FAST_HASH_RESUME_REFLECTED;
+        if (info->refin && php_crc_fast_hash_resume_works(info, resume)) {
+            continue;
+        }
+
+        resume->mode = PHP_CRC_FAST_HASH_RESUME_COMBINE;
+    }
+}
+
+template <size_t Index>
+static void php_crc_fast_hash_init(void *context, HashTable *args)
+{
+    php_crc_fast_hash_context *ctx = (php_crc_fast_hash_context*)context;
+
+    ctx->checksum = crc_fast_checksum(php_crc_fast_algorithms[Index].algorithm, "", 0);
+    ctx->length = 0;
+}
+
+template <size_t Index>
+static void php_crc_fast_hash_update(void *context, const unsigned char *buf, size_t count)
+{
+    php_crc_fast_hash_context *ctx = (php_crc_fast_hash_context*)context;
+
+    if (count == 0) {
+        return;
+    }
+
+    const php_crc_fast_hash_resume *resume = &php_crc_fast_hash_resumes[Index];
+
+    uint64_t stats_start = php_crc_fast_stats_start();
+    CrcFastAlgorithm algo = php_crc_fast_algorithms[Index].algorithm;
+
+    // nothing to carry on from on the first update
+    if (ctx->length == 0) {
+        ctx->checksum = crc_fast_checksum(algo, (const char*)buf, count);
+    } else if (EXPECTED(resume->mode != PHP_CRC_FAST_HASH_RESUME_COMBINE)) {
+        ctx->checksum = php_crc_fast_hash_resume_checksum(resume, ctx->checksum, (const char*)buf, count);
+    } else {
+        ctx->checksum = crc_fast_checksum_combine(algo, ctx->checksum, crc_fast_checksum(algo, (const char*)buf, count), count);
+    }
+
+    ctx->length += count;
+    php_crc_fast_stats_record(PHP_CRC_FAST_STATS_EXT_HASH, php_crc_fast_algorithms[Index].id, false, count, stats_start);
+}
+
+template <size_t Index>
+static void php_crc_fast_hash_final(unsigned char *digest, void *context)
+{
+    php_crc_fast_hash_context *ctx = (php_crc_fast_hash_context*)context;
+    uint64_t result = php_crc_fast_reverse_bytes_if_needed(ctx->checksum, php_crc_fast_algorithms[Index].id);
+    constexpr size_t size = php_crc_fast_algorithms[Index].width / 8;
+
+    // big-endian, to match CrcFast\hash(..., binary: true)
+    for (size_t i = 0; i < size; i++) {
+        digest[i] = (unsigned char)(result >> (8 * (size - 1 - i)));
+    }
+}
+
+#define PHP_CRC_FAST_HASH_OPS(index) { \
+    php_crc_fast_algorithms[index].hash_name, \
+    php_crc_fast_hash_init<index>, \
+    php_crc_fast_hash_update<index>, \
+    php_crc_fast_hash_final<index>, \
+    php_hash_copy, \
+    php_hash_serialize, \
+    php_hash_unserialize, \
+    PHP_CRC_FAST_HASH_SPEC, \
+    php_crc_fast_algorithms[index].width / 8, \
+    php_crc_fast_algorithms[index].width / 8, \
+    sizeof(php_crc_fast_hash_context), \
+    0 \
+}
+
+/* One backend per entry in php_crc_fast_algorithms, named after its hash_name. ext/hash won't let us replace
+ * algorithms it already registered (crc32, crc32b, crc32c), so these use their own names */
+template <size_t... Index>
+struct php_crc_fast_hash_ops_table {
+    static constexpr php_hash_ops ops[sizeof...(Index)] = {PHP_CRC_FAST_HASH_OPS(Index)...};
+};
+
+template <size_t... Index>
+static constexpr const php_hash_ops *php_crc_fast_hash_ops_build(std::index_sequence<Index...>)
+{
+    return php_crc_fast_hash_ops_table<Index...>::ops;
+}
+
+static const php_hash_ops *php_crc_fast_hash_ops =
+    php_crc_fast_hash_ops_build(std::make_index_sequence<PHP_CRC_FAST_ALGORITHM_COUNT>());
+
+/* Helper function to find a built-in algorithm by its short name, as used by the ext/hash backends and the
+ * stream filters */
+static inline bool php_crc_fast_get_algorithm_by_name(const char *name, zend_long *algorithm_out)
+{
+    for (size_t i = 0; i < PHP_CRC_FAST_ALGORITHM_COUNT; i++) {
+        if (strcasecmp(name, php_crc_fast_algorithms[i].hash_name) == 0) {
+            *algorithm_out = php_crc_fast_algorithms[i].id;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Stream filters
+ *
+ * "crcfast.digest" feeds everything passing through the stream into the CrcFast\Digest given as the
+ * filter parameter, "crcfast.<name>" (e.g. "crcfast.crc64nvme") does the same but also checks that the
+ * Digest uses that algorithm. Buckets are passed on untouched, so the checksum is computed while the
+ * data is copied, and can be read from the Digest at any point. */
+typedef struct _php_crc_fast_filter_data {
+    zend_object *digest;  // The CrcFast\Digest being fed, we hold a reference
+    zend_long algorithm;  // The algorithm from "crcfast.<name>", or 0 for "crcfast.digest"
+} php_crc_fast_filter_data;
+
+static php_stream_filter_status_t php_crc_fast_filter(
+    php_stream *stream,
+    php_stream_filter *thisfilter,
+    php_stream_bucket_brigade *buckets_in,
+    php_stream_bucket_brigade *buckets_out,
+    size_t *bytes_consumed,
+    int flags)
+{
+    php_crc_fast_filter_data *data = (php_crc_fast_filter_data*)Z_PTR(thisfilter->abstract);
+    php_crc_fast_digest_obj *obj = php_crc_fast_digest_from_obj(data->digest);
+    php_stream_bucket *bucket;
+    size_t consumed = 0;
+    uint64_t stats_start = php_crc_fast_stats_start();
+
+    // The Digest can be constructed or unserialized again while attached, which may fail or change its algorithm.
+    // Only checked when there's data, so closing the stream afterwards doesn't warn again.
+    bool usable = false;
+    if (!buckets_in->head) {
+        usable = true;
+    } else if (!obj->digest) {
+        php_error_docref(NULL, E_WARNING, "Digest object not initialized. Call constructor first");
+    } else if (data->algorithm && (obj->is_custom || obj->algorithm != data->algorithm)) {
+        php_error_docref(NULL, E_WARNING, "Digest algorithm no longer matches filter \"crcfast.%s\"",
+            php_crc_fast_find_algorithm(data->algorithm)->hash_name);
+    } else {
+        usable = true;
+    }
+
+    if (!usable) {
+        while ((bucket = buckets_in->head) != NULL) {
+            php_stream_bucket_unlink(bucket);
+            php_stream_bucket_delref(bucket);
+        }
+        return PSFS_ERR_FATAL;
+    }
+
+    while ((bucket = buckets_in->head) != NULL) {
+        php_stream_bucket_unlink(bucket);
+        php_crc_fast_digest_obj_update(obj, bucket->buf, bucket->buflen);
+        consumed += bucket->buflen;
+        php_stream_bucket_append(buckets_out, bucket);
+    }
+
+    if (consumed > 0) {
+        php_crc_fast_stats_record(PHP_CRC_FAST_STATS_FILTER, obj->algorithm, obj->is_custom, consumed, stats_start);
+    }
+
+    if (bytes_consumed) {
+        *bytes_consumed = consumed;
+    }
+
+    return PSFS_PASS_ON;
+}
+
+static void php_crc_fast_filter_dtor(php_stream_filter *thisfilter)
+{
+    php_crc_fast_filter_data *data = (php_crc_fast_filter_data*)Z_PTR(thisfilter->abstract);
+
+    if (data) {
+        OBJ_RELEASE(data->digest);
+        efree(data);
+    }
+}
+
+static const php_stream_filter_ops php_crc_fast_filter_ops = {
+    php_crc_fast_filter,
+    php_crc_fast_filter_dtor,
+    "crcfast.*"
+};
+
+static php_stream_filter *php_crc_fast_filter_create(const char *filtername, zval *filterparams, uint8_t persistent)
+{
+    if (persistent) {
+        php_error_docref(NULL, E_WARNING, "Filter \"%s\" cannot be used on persistent streams", filtername);
+        return NULL;
+    }
+
+    if (!filterparams || Z_TYPE_P(filterparams) != IS_OBJECT ||
+        !instanceof_function(Z_OBJCE_P(filterparams), php_crc_fast_digest_ce)) {
+        php_error_docref(NULL, E_WARNING, "Filter \"%s\" requires a CrcFast\\Digest parameter", filtername);
+        return NULL;
+    }
+
+    php_crc_fast_digest_obj *obj = Z_CRC_FAST_DIGEST_P(filterparams);
+    if (!obj->digest) {
+        php_error_docref(NULL, E_WARNING, "Digest object not initialized. Call constructor first");
+        return NULL;
+    }
+
+    // "crcfast.digest" takes any Digest, "crcfast.<name>" only a Digest for that algorithm
+    const char *name = filtername + sizeof("crcfast.") - 1;
+    zend_long algorithm = 0;
+    if (strcasecmp(name, "digest") != 0) {
+        if (!php_crc_fast_get_algorithm_by_name(name, &algorithm)) {
+            php_error_docref(NULL, E_WARNING, "Unknown algorithm in filter name \"%s\"", filtername);
+            return NULL;
+        }
+
+        if (obj->is_custom || obj->algorithm != algorithm) {
+            php_error_docref(NULL, E_WARNING, "Digest algorithm does not match filter \"%s\"", filtername);
+            return NULL;
+        }
+    }
+
+    php_crc_fast_filter_data *data = (php_crc_fast_filter_data*)emalloc(sizeof(php_crc_fast_filter_data));
+    data->digest = Z_OBJ_P(filterparams);
+    data->algorithm = algorithm;
+    GC_ADDREF(data->digest);
+
+    return php_stream_filter_alloc(&php_crc_fast_filter_ops, data, persistent);
+}
+
+static const php_stream_filter_factory php_crc_fast_filter_factory = {
+    php_crc_fast_filter_create
+};
+
 /* {{{ PHP_RINIT_FUNCTION */
 PHP_RINIT_FUNCTION(crc_fast)
 {
@@ -1191,6 +5599,254 @@ PHP_RINIT_FUNCTION(crc_fast)
 }
 /* }}} */
 
+/* Loading named custom algorithms from the crc_fast.custom_algorithms file
+ *
+ * The file is INI-formatted, with one section per algorithm:
+ *
+ *   [CRC-32/ACME]
+ *   id = 1
+ *   width = 32
+ *   poly = 0x1EDC6F41
+ *   init = 0xFFFFFFFF
+ *   refin = true
+ *   refout = true
+ *   xorout = 0xFFFFFFFF
+ *   check = 0xE3069283
+ *
+ * which registers CrcFast\CRC_32_ACME = PHP_CRC_FAST_CUSTOM_BASE + id. Keys are generated and the check value is
+ * validated here, once per process, instead of on every request.
+ */
+PHP_INI_BEGIN()
+    PHP_INI_ENTRY("crc_fast.custom_algorithms", "", PHP_INI_SYSTEM, NULL)
+    PHP_INI_ENTRY("crc_fast.stats", "0", PHP_INI_SYSTEM, NULL)
+    PHP_INI_ENTRY("crc_fast.stats_timing", "0", PHP_INI_SYSTEM, NULL)
+PHP_INI_END()
+
+#define PHP_CRC_FAST_CUSTOM_FIELD_ID     (1 << 0)
+#define PHP_CRC_FAST_CUSTOM_FIELD_WIDTH  (1 << 1)
+#define PHP_CRC_FAST_CUSTOM_FIELD_POLY   (1 << 2)
+#define PHP_CRC_FAST_CUSTOM_FIELD_INIT   (1 << 3)
+#define PHP_CRC_FAST_CUSTOM_FIELD_REFIN  (1 << 4)
+#define PHP_CRC_FAST_CUSTOM_FIELD_REFOUT (1 << 5)
+#define PHP_CRC_FAST_CUSTOM_FIELD_XOROUT (1 << 6)
+#define PHP_CRC_FAST_CUSTOM_FIELD_CHECK  (1 << 7)
+#define PHP_CRC_FAST_CUSTOM_FIELD_ALL    0xFF
+
+typedef struct _php_crc_fast_custom_parser {
+    const char *filename;
+    int module_number;
+    zend_string *name;  // Section currently being parsed, NULL before the first one
+    uint32_t fields;  // PHP_CRC_FAST_CUSTOM_FIELD_* seen in the current section
+    bool invalid;  // Whether the current section already failed
+    php_crc_fast_custom_algorithm current;
+} php_crc_fast_custom_parser;
+
+/* Helper function to parse an unsigned integer from the definition file, in decimal or 0x-prefixed hex */
+static bool php_crc_fast_custom_parse_uint(zval *value, uint64_t *out)
+{
+    if (Z_TYPE_P(value) != IS_STRING || Z_STRLEN_P(value) == 0 || Z_STRVAL_P(value)[0] == '-') {
+        return false;
+    }
+
+    char *end;
+    errno = 0;
+    *out = (uint64_t)strtoull(Z_STRVAL_P(value), &end, 0);
+
+    return errno == 0 && *end == '\0';
+}
+
+/* Helper function to add the section just parsed, if it's complete and valid */
+static void php_crc_fast_custom_finish_section(php_crc_fast_custom_parser *parser)
+{
+    if (!parser->name) {
+        return;
+    }
+
+    php_crc_fast_custom_algorithm *current = &parser->current;
+    const char *name = ZSTR_VAL(parser->name);
+    const char *error = NULL;
+
+    // Build the constant name the same way as the built-in ones, e.g. CRC-32/ACME -> CrcFast\CRC_32_ACME
+    std::string constant = "CrcFast\\";
+    for (const char *c = name; *c; c++) {
+        constant += isalnum((unsigned char)*c) ? (char)toupper((unsigned char)*c) : '_';
+    }
+    std::string lookup = "crcfast" + constant.substr(7);
+
+    if (parser->invalid) {
+        // Already reported
+    } else if ((parser->fields & PHP_CRC_FAST_CUSTOM_FIELD_ALL) != PHP_CRC_FAST_CUSTOM_FIELD_ALL) {
+        error = "id, width, poly, init, refin, refout, xorout and check are all required";
+    } else if (!isalpha((unsigned char)name[0])) {
+        error = "name must start with a letter";
+    } else if (current->params.width != 32 && current->params.width != 64) {
+        error = "width must be 32 or 64";
+    } else if (current->params.width == 32
+        && (current->params.poly | current->params.init | current->params.xorout | current->params.check) > 0xFFFFFFFFULL) {
+        error = "values exceed the maximum for a 32-bit width";
+    } else if (php_crc_fast_get_custom_algorithm(current->id) != NULL) {
+        error = "id is already used by another custom algorithm";
+    } else if (zend_get_constant_str(lookup.c_str(), lookup.length()) != NULL) {
+        error = "a constant with this name already exists";
+    } else {
+        CrcFastParams generated = crc_fast_get_custom_params(
+            name,
+            current->params.width,
+            current->params.poly,
+            current->params.init,
+            current->params.refin,
+            current->params.xorout,
+            current->params.check
+        );
+        memcpy(current->keys, generated.keys, sizeof(current->keys));
+
+        current->params.algorithm = (current->params.width == 32) ? CrcFastAlgorithm::Crc32Custom : CrcFastAlgorithm::Crc64Custom;
+        current->params.key_count = 23;
+        current->params.keys = current->keys;
+
+        if (crc_fast_checksum_with_params(current->params, "123456789", 9) != current->params.check) {
+            error = "computed check value does not match check";
+        }
+    }
+
+    if (error) {
+        php_error_docref(NULL, E_CORE_WARNING,
+            "Skipping custom algorithm '%s' in %s: %s", name, parser->filename, error);
+    } else if (!parser->invalid) {
+        php_crc_fast_custom_algorithms = (php_crc_fast_custom_algorithm*)perealloc(php_crc_fast_custom_algorithms,
+            (php_crc_fast_custom_algorithm_count + 1) * sizeof(php_crc_fast_custom_algorithm), 1);
+
+        php_crc_fast_custom_algorithm *added = &php_crc_fast_custom_algorithms[php_crc_fast_custom_algorithm_count++];
+        *added = *current;
+        added->name = pestrdup(name, 1);
+
+        zend_register_long_constant(constant.c_str(), constant.length(), added->id, CONST_PERSISTENT, parser->module_number);
+    }
+
+    zend_string_release(parser->name);
+    parser->name = NULL;
+}
+
+/* Callback for zend_parse_ini_file(), see php_crc_fast_custom_algorithms_load() */
+static void php_crc_fast_custom_parser_cb(zval *arg1, zval *arg2, zval *arg3, int callback_type, void *arg)
+{
+    php_crc_fast_custom_parser *parser = (php_crc_fast_custom_parser*)arg;
+
+    if (callback_type == ZEND_INI_PARSER_SECTION) {
+        php_crc_fast_custom_finish_section(parser);
+
+        parser->name = zend_string_copy(Z_STR_P(arg1));
+        parser->fields = 0;
+        parser->invalid = false;
+        memset(&parser->current, 0, sizeof(parser->current));
+        return;
+    }
+
+    if (callback_type != ZEND_INI_PARSER_ENTRY || !parser->name || parser->invalid) {
+        return;
+    }
+
+    const char *key = Z_STRVAL_P(arg1);
+    php_crc_fast_custom_algorithm *current = &parser->current;
+    uint64_t value = 0;
+    bool valid;
+
+    if (strcmp(key, "refin") == 0 || strcmp(key, "refout") == 0) {
+        valid = Z_TYPE_P(arg2) == IS_STRING;
+        bool flag = valid && zend_ini_parse_bool(Z_STR_P(arg2));
+        if (key[3] == 'i') {
+            current->params.refin = flag;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_REFIN;
+        } else {
+            current->params.refout = flag;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_REFOUT;
+        }
+    } else {
+        valid = php_crc_fast_custom_parse_uint(arg2, &value);
+
+        if (strcmp(key, "id") == 0) {
+            valid = valid && value <= PHP_CRC_FAST_CUSTOM_MAX_ID;
+            current->id = PHP_CRC_FAST_CUSTOM_BASE + (zend_long)value;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_ID;
+        } else if (strcmp(key, "width") == 0) {
+            valid = valid && value <= 64;
+            current->params.width = (uint8_t)value;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_WIDTH;
+        } else if (strcmp(key, "poly") == 0) {
+            current->params.poly = value;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_POLY;
+        } else if (strcmp(key, "init") == 0) {
+            current->params.init = value;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_INIT;
+        } else if (strcmp(key, "xorout") == 0) {
+            current->params.xorout = value;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_XOROUT;
+        } else if (strcmp(key, "check") == 0) {
+            current->params.check = value;
+            parser->fields |= PHP_CRC_FAST_CUSTOM_FIELD_CHECK;
+        } else {
+            php_error_docref(NULL, E_CORE_WARNING,
+                "Skipping custom algorithm '%s' in %s: unknown setting '%s'", ZSTR_VAL(parser->name), parser->filename, key);
+            parser->invalid = true;
+            return;
+        }
+    }
+
+    if (!valid) {
+        php_error_docref(NULL, E_CORE_WARNING,
+            "Skipping custom algorithm '%s' in %s: invalid value for '%s'", ZSTR_VAL(parser->name), parser->filename, key);
+        parser->invalid = true;
+    }
+}
+
+/* Load the custom algorithms from the crc_fast.custom_algorithms file, if any, and register their constants */
+static void php_crc_fast_custom_algorithms_load(const char *filename, int module_number)
+{
+    if (!filename || !*filename) {
+        return;
+    }
+
+    php_crc_fast_custom_parser parser;
+    memset(&parser, 0, sizeof(parser));
+    parser.filename = filename;
+    parser.module_number = module_number;
+
+    zend_file_handle file_handle;
+    zend_stream_init_filename(&file_handle, filename);
+
+    if (zend_parse_ini_file(&file_handle, true, ZEND_INI_SCANNER_NORMAL, php_crc_fast_custom_parser_cb, &parser) == FAILURE) {
+        php_error_docref(NULL, E_CORE_WARNING, "Failed to load custom algorithms from %s", filename);
+    } else {
+        php_crc_fast_custom_finish_section(&parser);
+    }
+
+    if (parser.name) {
+        zend_string_release(parser.name);
+    }
+
+    zend_destroy_file_handle(&file_handle);
+
+    // Entries were copied while the array was growing, so point their params at their final keys
+    for (uint32_t i = 0; i < php_crc_fast_custom_algorithm_count; i++) {
+        php_crc_fast_custom_algorithms[i].params.keys = php_crc_fast_custom_algorithms[i].keys;
+    }
+}
+
+/* Free the custom algorithms loaded at MINIT */
+static void php_crc_fast_custom_algorithms_free(void)
+{
+    for (uint32_t i = 0; i < php_crc_fast_custom_algorithm_count; i++) {
+        pefree(php_crc_fast_custom_algorithms[i].name, 1);
+    }
+
+    if (php_crc_fast_custom_algorithms) {
+        pefree(php_crc_fast_custom_algorithms, 1);
+        php_crc_fast_custom_algorithms = NULL;
+    }
+
+    php_crc_fast_custom_algorithm_count = 0;
+}
+
 /* {{{ PHP_MINFO_FUNCTION */
 PHP_MINFO_FUNCTION(crc_fast)
 {
@@ -1201,7 +5857,53 @@ PHP_MINFO_FUNCTION(crc_fast)
 	php_info_print_table_row(2, "crc_fast CRC-32/ISCSI target", crc_fast_get_calculator_target(CrcFastAlgorithm::Crc32Iscsi));
 	php_info_print_table_row(2, "crc_fast CRC-32/ISO-HDLC target", crc_fast_get_calculator_target(CrcFastAlgorithm::Crc32IsoHdlc));
 	php_info_print_table_row(2, "crc_fast all other targets", crc_fast_get_calculator_target(CrcFastAlgorithm::Crc64Nvme));
+	php_info_print_table_row(2, "crc_fast custom algorithms", std::to_string(php_crc_fast_custom_algorithm_count).c_str());
+#ifdef HAVE_CRC_FAST_IO_URING
+	php_info_print_table_row(2, "crc_fast io_uring support", "enabled");
+#else
+	php_info_print_table_row(2, "crc_fast io_uring support", "disabled");
+#endif
+	php_info_print_table_row(2, "crc_fast stats", php_crc_fast_stats_enabled ? "enabled" : "disabled");
 	php_info_print_table_end();
+
+	if (php_crc_fast_stats_enabled) {
+		php_crc_fast_stats_totals totals;
+		php_crc_fast_stats_collect(&totals);
+
+		php_info_print_table_start();
+		php_info_print_table_header(5, "Algorithm", "Entry point", "Calls", "Bytes", "Time (ns)");
+		for (size_t a = 0; a < PHP_CRC_FAST_STATS_ALGORITHM_COUNT; a++) {
+			for (size_t e = 0; e < PHP_CRC_FAST_STATS_ENTRY_COUNT; e++) {
+				const uint64_t *counter = totals.counters[a][e];
+				if (counter[0] == 0) {
+					continue;
+				}
+
+				php_info_print_table_row(5,
+					php_crc_fast_stats_algorithm_name(a),
+					php_crc_fast_stats_entry_names[e],
+					std::to_string(counter[0]).c_str(),
+					std::to_string(counter[1]).c_str(),
+					php_crc_fast_stats_timing ? std::to_string(counter[2]).c_str() : "-");
+			}
+		}
+		php_info_print_table_end();
+
+		php_info_print_table_start();
+		php_info_print_table_header(2, "Size (bytes, from)", "Calls");
+		for (size_t b = 0; b < PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS; b++) {
+			if (totals.histogram[b] == 0) {
+				continue;
+			}
+
+			php_info_print_table_row(2,
+				std::to_string(php_crc_fast_stats_bucket_min(b)).c_str(),
+				std::to_string(totals.histogram[b]).c_str());
+		}
+		php_info_print_table_end();
+	}
+
+	DISPLAY_INI_ENTRIES();
 }
 /* }}} */
 
@@ -1211,6 +5913,17 @@ PHP_MINIT_FUNCTION(crc_fast)
     // Register constants and symbols
     register_crc_fast_symbols(0);
 
+    // Load named custom algorithms, after the built-in constants so clashes can be detected
+    REGISTER_INI_ENTRIES();
+    php_crc_fast_custom_algorithms_load(INI_STR("crc_fast.custom_algorithms"), module_number);
+
+    // Runtime statistics are per process, so these can't change per request
+    php_crc_fast_stats_enabled = INI_BOOL("crc_fast.stats");
+    php_crc_fast_stats_timing = php_crc_fast_stats_enabled && INI_BOOL("crc_fast.stats_timing");
+
+    // Built once, now the named custom algorithms are known
+    php_crc_fast_supported_algorithms_build();
+
     // Register the Digest class using the auto-generated function
     php_crc_fast_digest_ce = register_class_CrcFast_Digest();
 
@@ -1223,7 +5936,7 @@ PHP_MINIT_FUNCTION(crc_fast)
     // With std first, offset should be 0
     php_crc_fast_digest_object_handlers.offset = offsetof(php_crc_fast_digest_obj, std);
     php_crc_fast_digest_object_handlers.free_obj = php_crc_fast_digest_free_obj;
-    php_crc_fast_digest_object_handlers.clone_obj = NULL;
+    php_crc_fast_digest_object_handlers.clone_obj = php_crc_fast_digest_clone_obj;
 
     // Register the Params class using the auto-generated function
     php_crc_fast_params_ce = register_class_CrcFast_Params();
@@ -1237,17 +5950,81 @@ PHP_MINIT_FUNCTION(crc_fast)
     php_crc_fast_params_object_handlers.free_obj = php_crc_fast_params_free_obj;
     php_crc_fast_params_object_handlers.clone_obj = NULL; // No cloning support
 
+    // Register the MultiDigest class using the auto-generated function
+    php_crc_fast_multi_digest_ce = register_class_CrcFast_MultiDigest();
+
+    // Set up the create_object handler for the class
+    php_crc_fast_multi_digest_ce->create_object = php_crc_fast_multi_digest_create_object;
+
+    // Initialize the object handlers
+    memcpy(&php_crc_fast_multi_digest_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+    php_crc_fast_multi_digest_object_handlers.offset = offsetof(php_crc_fast_multi_digest_obj, std);
+    php_crc_fast_multi_digest_object_handlers.free_obj = php_crc_fast_multi_digest_free_obj;
+    php_crc_fast_multi_digest_object_handlers.clone_obj = NULL; // No cloning support
+
+    // Register the PendingHash class using the auto-generated function
+    php_crc_fast_pending_hash_ce = register_class_CrcFast_PendingHash();
+
+    // Set up the create_object handler for the class
+    php_crc_fast_pending_hash_ce->create_object = php_crc_fast_pending_hash_create_object;
+
+    // Initialize the object handlers
+    memcpy(&php_crc_fast_pending_hash_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+    php_crc_fast_pending_hash_object_handlers.offset = offsetof(php_crc_fast_pending_hash_obj, std);
+    php_crc_fast_pending_hash_object_handlers.free_obj = php_crc_fast_pending_hash_free_obj;
+    php_crc_fast_pending_hash_object_handlers.clone_obj = NULL; // No cloning support, the worker has one owner
+
+    // Register the algorithms with ext/hash, so hash(), hash_init(), hash_file(), etc. can use them
+    php_crc_fast_hash_resume_init();
+    for (size_t i = 0; i < PHP_CRC_FAST_ALGORITHM_COUNT; i++) {
+        php_hash_register_algo(php_crc_fast_hash_ops[i].algo, &php_crc_fast_hash_ops[i]);
+    }
+
+    // Register the "crcfast.*" stream filters
+    if (php_stream_filter_register_factory("crcfast.*", &php_crc_fast_filter_factory) == FAILURE) {
+        return FAILURE;
+    }
+
+    return SUCCESS;
+}
+/* }}} */
+
+/* {{{ PHP_MSHUTDOWN_FUNCTION */
+PHP_MSHUTDOWN_FUNCTION(crc_fast)
+{
+    php_stream_filter_unregister_factory("crcfast.*");
+
+    php_crc_fast_pending_pool_shutdown();
+
+    php_crc_fast_params_cache.clear();
+
+    php_crc_fast_supported_algorithms_free();
+
+    php_crc_fast_custom_algorithms_free();
+
+    UNREGISTER_INI_ENTRIES();
+
     return SUCCESS;
 }
+/* }}} */
+
+/* {{{ crc_fast_deps */
+static const zend_module_dep crc_fast_deps[] = {
+	ZEND_MOD_REQUIRED("hash")
+	ZEND_MOD_END
+};
+/* }}} */
 
 /* {{{ crc_fast_module_entry */
 extern "C" {
 zend_module_entry crc_fast_module_entry = {
-	STANDARD_MODULE_HEADER,
+	STANDARD_MODULE_HEADER_EX,
+	NULL,
+	crc_fast_deps,
 	"crc_fast",					/* Extension name */
 	ext_functions,			    /* zend_function_entry */
 	PHP_MINIT(crc_fast),		/* PHP_MINIT - Module initialization */
-	NULL,						/* PHP_MSHUTDOWN - Module shutdown */
+	PHP_MSHUTDOWN(crc_fast),	/* PHP_MSHUTDOWN - Module shutdown */
 	PHP_RINIT(crc_fast),		/* PHP_RINIT - Request initialization */
 	NULL,						/* PHP_RSHUTDOWN - Request shutdown */
 	PHP_MINFO(crc_fast),		/* PHP_MINFO - Module info */
@@ -31,6 +31,64 @@ extern zend_module_entry crc_fast_module_entry;
 
 # define PHP_CRC_FAST_VERSION "1.1.0"
 
+/* Default read size when streaming files, large enough to keep the SIMD paths busy */
+# define PHP_CRC_FAST_DEFAULT_CHUNK_SIZE (1024 * 1024)
+
+/* Largest buffer allocated for reading a stream, whatever chunk size was asked for */
+# define PHP_CRC_FAST_MAX_STREAM_BUFFER (1024 * 1024)
+
+/* Largest chunk_size hash_file() accepts for the I/O modes that allocate chunk_size (times the queue depth) up front */
+# define PHP_CRC_FAST_MAX_CHUNK_SIZE (64 * 1024 * 1024)
+
+/* Chunk size for feeding several digests the same data, small enough to stay in cache between them */
+# define PHP_CRC_FAST_MULTI_CHUNK_SIZE (64 * 1024)
+
+/* Most parts CrcFast\hash_chunks() and hash_file_chunks() split data into, each costs native memory until returned */
+# define PHP_CRC_FAST_MAX_CHUNKS (1024 * 1024)
+
+/* Smallest range worth handing to its own thread when hashing files in parallel */
+# define PHP_CRC_FAST_PARALLEL_MIN_RANGE (16 * 1024 * 1024)
+
+/* Upper bound on worker threads for a single call */
+# define PHP_CRC_FAST_MAX_THREADS 1024
+
+/* Upper bound on threads running CrcFast\hash_file_async() work per process, anything more is queued */
+# define PHP_CRC_FAST_MAX_ASYNC_WORKERS 16
+
+/* Upper bound on distinct custom parameter sets whose generated keys are cached per process */
+# define PHP_CRC_FAST_PARAMS_CACHE_MAX_ENTRIES 1024
+
+/* Size histogram buckets for crc_fast.stats: 0 bytes, then one per power of two, with the last from 1GiB up */
+# define PHP_CRC_FAST_STATS_HISTOGRAM_BUCKETS 32
+
+/* Threads that can count into crc_fast.stats blocks of their own at once, any more share one */
+# define PHP_CRC_FAST_STATS_MAX_BLOCKS 64
+
+/* Output formats for checksums, see CrcFast\FORMAT_* (false/true for $binary map to HEX/BINARY) */
+# define PHP_CRC_FAST_FORMAT_HEX       0  // Lowercase hex
+# define PHP_CRC_FAST_FORMAT_BINARY    1  // Big-endian bytes
+# define PHP_CRC_FAST_FORMAT_HEX_UPPER 2  // Uppercase hex
+# define PHP_CRC_FAST_FORMAT_BINARY_LE 3  // Little-endian bytes
+# define PHP_CRC_FAST_FORMAT_BASE64    4  // Base64 of the big-endian bytes
+# define PHP_CRC_FAST_FORMAT_INT       5  // Integer, as hash_int()
+
+/* How CrcFast\hash_file() reads plain files, see CrcFast\IO_* */
+# define PHP_CRC_FAST_IO_DEFAULT  0  // The library for plain files, stream wrappers for anything else
+# define PHP_CRC_FAST_IO_BUFFERED 1  // pread() with POSIX_FADV_SEQUENTIAL, dropping pages behind with POSIX_FADV_DONTNEED
+# define PHP_CRC_FAST_IO_MMAP     2  // mmap() with MADV_SEQUENTIAL
+# define PHP_CRC_FAST_IO_DIRECT   3  // pread() with O_DIRECT into aligned buffers
+# define PHP_CRC_FAST_IO_URING    4  // io_uring with several reads in flight, only if built with liburing
+
+/* Reads in flight for PHP_CRC_FAST_IO_URING */
+# define PHP_CRC_FAST_DEFAULT_QUEUE_DEPTH 8
+# define PHP_CRC_FAST_MAX_QUEUE_DEPTH     256
+
+/* Buffer, offset, and length alignment for PHP_CRC_FAST_IO_DIRECT, which covers the usual logical block sizes */
+# define PHP_CRC_FAST_DIRECT_ALIGNMENT 4096
+
+/* Format version of the array produced by CrcFast\Digest::__serialize() */
+# define PHP_CRC_FAST_DIGEST_SERIALIZE_VERSION 1
+
 # if defined(ZTS) && defined(COMPILE_DL_CRC_FAST)
 ZEND_TSRMLS_CACHE_EXTERN()
 # endif
@@ -40,6 +98,10 @@ typedef struct _php_crc_fast_digest_obj {
     zend_long algorithm;
     bool is_custom;  // Whether using custom parameters
     CrcFastParams custom_params;  // Custom parameters if is_custom is true
+    uint64_t custom_keys[23];  // Our own copy of custom_params.keys, which can outlive the Params object
+    uint64_t length;  // Total bytes hashed so far, including the prefix
+    uint64_t prefix_checksum;  // Raw checksum of data hashed before an unserialize or combine, outside the digest
+    uint64_t prefix_length;  // Bytes covered by prefix_checksum, 0 if there is no prefix
     zend_object std;  // MUST be last
 } php_crc_fast_digest_obj;
 
@@ -53,6 +115,28 @@ static inline php_crc_fast_digest_obj *php_crc_fast_digest_from_obj(zend_object
 
 #define Z_CRC_FAST_DIGEST_P(zv) php_crc_fast_digest_from_obj(Z_OBJ_P(zv))
 
+/* One of the algorithms being calculated by CrcFast\hash_multi() or CrcFast\MultiDigest */
+typedef struct _php_crc_fast_multi_entry {
+    CrcFastDigestHandle *digest;
+    zend_long algorithm;
+    bool is_custom;  // Whether using custom parameters
+    CrcFastParams custom_params;  // Custom parameters if is_custom is true
+} php_crc_fast_multi_entry;
+
+/* Define the CrcFast\MultiDigest class */
+typedef struct _php_crc_fast_multi_digest_obj {
+    php_crc_fast_multi_entry *entries;
+    uint32_t count;
+    zval algorithms;  // The algorithms array as given, whose keys are used for the results
+    zend_object std;  // MUST be last
+} php_crc_fast_multi_digest_obj;
+
+static inline php_crc_fast_multi_digest_obj *php_crc_fast_multi_digest_from_obj(zend_object *obj) {
+    return container_of(obj, php_crc_fast_multi_digest_obj, std);
+}
+
+#define Z_CRC_FAST_MULTI_DIGEST_P(zv) php_crc_fast_multi_digest_from_obj(Z_OBJ_P(zv))
+
 /* Define the CrcFast\Params class */
 typedef struct _php_crc_fast_params_obj {
     CrcFastParams params;
@@ -66,6 +150,38 @@ static inline php_crc_fast_params_obj *php_crc_fast_params_from_obj(zend_object
 
 #define Z_CRC_FAST_PARAMS_P(zv) php_crc_fast_params_from_obj(Z_OBJ_P(zv))
 
+/* Define the CrcFast\PendingHash class, for a file being hashed on a background thread by CrcFast\hash_file_async() */
+struct php_crc_fast_pending_state;  // Shared with the worker thread, see php_crc_fast.cpp
+
+typedef struct _php_crc_fast_pending_hash_obj {
+    struct php_crc_fast_pending_state *state;  // NULL unless created by hash_file_async()
+    zend_string *filename;  // For error messages
+    zval stream;  // Readable stream from getStream(), UNDEF until it's asked for
+    zend_object std;  // MUST be last
+} php_crc_fast_pending_hash_obj;
+
+static inline php_crc_fast_pending_hash_obj *php_crc_fast_pending_hash_from_obj(zend_object *obj) {
+    return container_of(obj, php_crc_fast_pending_hash_obj, std);
+}
+
+#define Z_CRC_FAST_PENDING_HASH_P(zv) php_crc_fast_pending_hash_from_obj(Z_OBJ_P(zv))
+
+/* A named custom algorithm from the crc_fast.custom_algorithms file, loaded once at MINIT */
+typedef struct _php_crc_fast_custom_algorithm {
+    zend_long id;  // Value of its CrcFast\ constant
+    char *name;  // Name as given in the file, e.g. "CRC-32/ACME"
+    CrcFastParams params;
+    uint64_t keys[23];  // Storage for params.keys
+} php_crc_fast_custom_algorithm;
+
+/* Context for the ext/hash backends, see php_hash_register_algo() in MINIT */
+typedef struct _php_crc_fast_hash_context {
+    uint64_t checksum;  // Running checksum of everything hashed so far
+    uint64_t length;    // Number of bytes hashed so far
+} php_crc_fast_hash_context;
+
+#define PHP_CRC_FAST_HASH_SPEC "qq."
+
 /* Algorithm constants that will be exposed to PHP, with room for expansion */
 // CRC-32
 #define PHP_CRC_FAST_CRC32_AIXM       10000
@@ -95,4 +211,25 @@ static inline php_crc_fast_params_obj *php_crc_fast_params_from_obj(zend_object
 #define PHP_CRC_FAST_CRC64_WE         20050
 #define PHP_CRC_FAST_CRC64_XZ         20060
 
+// Custom algorithms from the crc_fast.custom_algorithms file, whose "id" is added to the base
+#define PHP_CRC_FAST_CUSTOM_BASE      30000
+#define PHP_CRC_FAST_CUSTOM_MAX_ID    9999
+
+/* Everything known about a built-in algorithm, see php_crc_fast_algorithms and CrcFast\get_algorithm_info() */
+typedef struct _php_crc_fast_algorithm_info {
+    zend_long id;  // Value of its CrcFast\ constant
+    CrcFastAlgorithm algorithm;  // What the library calculates
+    uint8_t width;
+    uint64_t poly;
+    uint64_t init;
+    bool refin;
+    bool refout;
+    uint64_t xorout;
+    uint64_t check;  // Checksum of "123456789", as returned by CrcFast\hash_int()
+    bool reverse_bytes;  // Whether the result is byte-reversed, as PHP's hash('crc32') is
+    const char *name;  // Catalogue name, e.g. "CRC-64/NVME"
+    const char *supported_name;  // Key in CrcFast\get_supported_algorithms(), NULL if it isn't listed there
+    const char *hash_name;  // Name for ext/hash and the stream filters, e.g. "crc64nvme"
+} php_crc_fast_algorithm_info;
+
 #endif	/* PHP_CRC_FAST_H */
@@ -0,0 +1,77 @@
+--TEST--
+combine_many() test
+--EXTENSIONS--
+crc_fast
+--SKIPIF--
+<?php if (PHP_INT_SIZE < 8) die('skip 64-bit only'); ?>
+--FILE--
+<?php
+$data = str_repeat('123456789', 1000);
+$params = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+
+foreach ([CrcFast\CRC_64_NVME, CrcFast\CRC_32_ISCSI, CrcFast\CRC_32_PHP, $params] as $algorithm) {
+    foreach ([1, 7, 1000, 9000, 100000] as $chunkSize) {
+        $chunks = str_split($data, $chunkSize);
+
+        // mix of hex, binary and int checksums
+        $parts = [];
+        foreach ($chunks as $i => $chunk) {
+            $checksum = match ($i % 3) {
+                0 => CrcFast\hash($algorithm, $chunk),
+                1 => CrcFast\hash($algorithm, $chunk, true),
+                2 => CrcFast\hash_int($algorithm, $chunk),
+            };
+            $parts[] = [$checksum, strlen($chunk)];
+        }
+
+        if (CrcFast\combine_many($algorithm, $parts) !== CrcFast\hash($algorithm, $data)) {
+            echo "mismatch for chunk size $chunkSize\n";
+        }
+    }
+}
+
+var_dump(CrcFast\combine_many(CrcFast\CRC_64_NVME, [
+    ['29f5dbe7e2ff71d4', 4],
+    ['F3C774AFE7009FD7', 4],
+    [hex2bin('85894d772e0f40a7'), 1],
+]));
+var_dump(CrcFast\combine_many(CrcFast\CRC_32_ISCSI, [[0x18d12335, 5], ['c27e5db2', 4]], format: CrcFast\FORMAT_INT));
+var_dump(bin2hex(CrcFast\combine_many(CrcFast\CRC_32_ISCSI, [['18d12335', 5], ['c27e5db2', 4]], true)));
+
+// a single part is returned as-is, no parts is the checksum of nothing
+var_dump(CrcFast\combine_many(CrcFast\CRC_32_ISCSI, [['e3069283', 9]]));
+var_dump(CrcFast\combine_many(CrcFast\CRC_32_ISCSI, []));
+
+// empty parts don't change anything
+var_dump(CrcFast\combine_many(CrcFast\CRC_32_ISCSI, [['00000000', 0], ['e3069283', 9], ['00000000', 0]]));
+
+foreach ([
+    ['nope'],
+    [['e3069283']],
+    [['e306928', 9]],
+    [['zz069283', 9]],
+    [[0x100000000, 9]],
+    [['e3069283', -1]],
+    [['e3069283', '9']],
+] as $parts) {
+    try {
+        CrcFast\combine_many(CrcFast\CRC_32_ISCSI, $parts);
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+}
+?>
+--EXPECT--
+string(16) "ae8b14860a799888"
+int(3808858755)
+string(8) "e3069283"
+string(8) "e3069283"
+string(8) "00000000"
+string(8) "e3069283"
+Part 0 must be an array of [checksum, length]
+Part 0 must be an array of [checksum, length]
+Part 0 has an invalid checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Part 0 has an invalid checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Part 0 has an invalid checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Part 0 has an invalid length, expected a non-negative int
+Part 0 has an invalid length, expected a non-negative int
@@ -0,0 +1,60 @@
+--TEST--
+Custom algorithms from crc_fast.custom_algorithms test
+--EXTENSIONS--
+crc_fast
+--INI--
+crc_fast.custom_algorithms={PWD}/custom_algorithms.ini
+--FILE--
+<?php
+var_dump(CrcFast\CRC_32_ACME, CrcFast\CRC_64_ACME);
+
+$algorithms = CrcFast\get_supported_algorithms();
+var_dump($algorithms['CRC-32/ACME'], $algorithms['CRC-64/ACME']);
+
+// usable anywhere the built-in constants are
+var_dump(CrcFast\hash(CrcFast\CRC_32_ACME, '123456789'));
+var_dump(CrcFast\hash(CrcFast\CRC_64_ACME, '123456789'));
+var_dump(bin2hex(CrcFast\hash(CrcFast\CRC_32_ACME, '123456789', true)));
+
+var_dump(CrcFast\combine(
+    CrcFast\CRC_64_ACME,
+    CrcFast\hash(CrcFast\CRC_64_ACME, '1234'),
+    CrcFast\hash(CrcFast\CRC_64_ACME, '56789'),
+    5,
+    false
+));
+
+$digest = new CrcFast\Digest(CrcFast\CRC_32_ACME);
+$digest->update('1234')->update('56789');
+var_dump($digest->finalize());
+
+$resumed = unserialize(serialize((new CrcFast\Digest(CrcFast\CRC_64_ACME))->update('1234')));
+var_dump($resumed->update('56789')->finalize());
+
+var_dump(CrcFast\hash_multi([CrcFast\CRC_32_ACME, CrcFast\CRC_64_ACME], '123456789'));
+
+// unknown ids in the custom range are still rejected
+try {
+    CrcFast\hash(CrcFast\CRC_32_ACME + 100, '123456789');
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+int(30001)
+int(30002)
+int(30001)
+int(30002)
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+array(2) {
+  [0]=>
+  string(8) "e3069283"
+  [1]=>
+  string(16) "ae8b14860a799888"
+}
+Invalid algorithm constant 30101. Use CrcFast\get_supported_algorithms() to see valid values
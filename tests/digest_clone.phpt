@@ -0,0 +1,63 @@
+--TEST--
+Digest clone test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+// hash a shared prefix once, then branch
+$prefix = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+$prefix->update('1234');
+
+$first = clone $prefix;
+$second = clone $prefix;
+
+$first->update('56789');
+$second->update('abcdef');
+
+var_dump($first->finalize());
+var_dump($second->finalize() === CrcFast\hash(CrcFast\CRC_64_NVME, '1234abcdef'));
+
+// the original is untouched
+var_dump($prefix->finalize() === CrcFast\hash(CrcFast\CRC_64_NVME, '1234'));
+
+// clones of clones, and checkpoints along a stream
+$digest = new CrcFast\Digest(CrcFast\CRC_32_PHP);
+$checkpoints = [];
+foreach (str_split('123456789', 3) as $chunk) {
+    $digest->update($chunk);
+    $checkpoints[] = clone $digest;
+}
+foreach ($checkpoints as $checkpoint) {
+    var_dump($checkpoint->finalize());
+}
+var_dump((clone $checkpoints[0])->update('456789')->finalize());
+
+// clones combine and reset independently
+$clone = clone $first;
+$clone->reset();
+var_dump($clone->finalize());
+var_dump($first->finalize());
+$clone->update('1234')->combine((new CrcFast\Digest(CrcFast\CRC_64_NVME))->update('56789'));
+var_dump($clone->finalize());
+
+// custom parameters, outliving the Params object
+$digest = new CrcFast\Digest(new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283));
+$digest->update('1234');
+$clone = clone $digest;
+$clone->update('56789');
+var_dump($clone->finalize());
+var_dump($digest->finalize() === CrcFast\hash(CrcFast\CRC_32_ISCSI, '1234'));
+?>
+--EXPECT--
+string(16) "ae8b14860a799888"
+bool(true)
+bool(true)
+string(8) "9b0ead26"
+string(8) "70930f27"
+string(8) "181989fc"
+string(8) "181989fc"
+string(16) "0000000000000000"
+string(16) "ae8b14860a799888"
+string(16) "ae8b14860a799888"
+string(8) "e3069283"
+bool(true)
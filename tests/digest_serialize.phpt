@@ -0,0 +1,91 @@
+--TEST--
+Digest serialize / unserialize test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+// resume a partial checksum
+$digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+$digest->update('1234');
+$serialized = serialize($digest);
+
+$resumed = unserialize($serialized);
+var_dump($resumed instanceof CrcFast\Digest);
+$resumed->update('56789');
+var_dump($resumed->finalize());
+
+// the state is plain data
+$state = $digest->__serialize();
+var_dump($state[0], $state[1] === CrcFast\CRC_64_NVME, $state[3]);
+$state = (new CrcFast\Digest(CrcFast\CRC_32_ISCSI))->update('1234')->__serialize();
+var_dump(sprintf('%08x', $state[2]));
+
+// resumed digests can be serialized, cloned, combined and reset again
+$resumed = unserialize(serialize(unserialize($serialized)->update('56')));
+$clone = clone $resumed;
+var_dump($resumed->update('789')->finalize());
+var_dump($clone->finalize() === CrcFast\hash(CrcFast\CRC_64_NVME, '123456'));
+
+$head = (new CrcFast\Digest(CrcFast\CRC_64_NVME))->update('12');
+$head->combine(unserialize(serialize((new CrcFast\Digest(CrcFast\CRC_64_NVME))->update('3456'))));
+$head->combine((new CrcFast\Digest(CrcFast\CRC_64_NVME))->update('789'));
+var_dump($head->finalize());
+
+$resumed->reset();
+var_dump($resumed->finalize());
+var_dump($resumed->update('123456789')->finalizeReset());
+
+// CRC-32/PHP and an empty digest
+$digest = unserialize(serialize((new CrcFast\Digest(CrcFast\CRC_32_PHP))->update('123')));
+var_dump($digest->update('456789')->finalize());
+$digest = unserialize(serialize(new CrcFast\Digest(CrcFast\CRC_32_PHP)));
+var_dump($digest->update('123456789')->finalize());
+
+// custom parameters
+$digest = new CrcFast\Digest(new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283));
+$resumed = unserialize(serialize($digest->update('1234')));
+var_dump($resumed->update('56789')->finalize());
+
+// invalid data
+foreach ([
+    [2, CrcFast\CRC_64_NVME, 0, 0],
+    [1, CrcFast\CRC_64_NVME, 0, -1],
+    [1, 'nope', 0, 0],
+    [1, [32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0x12345678], 0, 0],
+    [1, CrcFast\CRC_32_ISCSI, 0x100000000, 1],
+] as $data) {
+    try {
+        (new ReflectionClass(CrcFast\Digest::class))->newInstanceWithoutConstructor()->__unserialize($data);
+        echo "no exception\n";
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+}
+
+try {
+    (new ReflectionClass(CrcFast\Digest::class))->newInstanceWithoutConstructor()->__unserialize([1, 99999, 0, 0]);
+} catch (Exception $e) {
+    echo "unknown algorithm\n";
+}
+?>
+--EXPECT--
+bool(true)
+string(16) "ae8b14860a799888"
+int(1)
+bool(true)
+int(4)
+string(8) "f63af4ee"
+string(16) "ae8b14860a799888"
+bool(true)
+string(16) "ae8b14860a799888"
+string(16) "0000000000000000"
+string(16) "ae8b14860a799888"
+string(8) "181989fc"
+string(8) "181989fc"
+string(8) "e3069283"
+Invalid serialization data for CrcFast\Digest object
+Invalid serialization data for CrcFast\Digest object
+Invalid serialization data for CrcFast\Digest object
+Invalid serialization data for CrcFast\Digest object
+Invalid serialization data for CrcFast\Digest object
+unknown algorithm
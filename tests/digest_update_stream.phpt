@@ -0,0 +1,73 @@
+--TEST--
+Digest::updateStream() test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$stream = fopen('php://memory', 'w+');
+fwrite($stream, '123456789');
+rewind($stream);
+
+// whole stream
+$digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+var_dump($digest->updateStream($stream));
+var_dump($digest->finalize());
+
+// limited length and tiny chunks, continuing where the stream left off
+rewind($stream);
+$digest = new CrcFast\Digest(CrcFast\CRC_32_ISCSI);
+var_dump($digest->updateStream($stream, 4, 3));
+var_dump(ftell($stream));
+var_dump($digest->updateStream($stream, 100, 2));
+var_dump($digest->finalize());
+
+// mixed with update()
+rewind($stream);
+fseek($stream, 4);
+$digest = new CrcFast\Digest(CrcFast\CRC_32_ISCSI);
+$digest->update('1234');
+var_dump($digest->updateStream($stream, null, 8192));
+var_dump($digest->finalize());
+
+// zero length and EOF
+var_dump($digest->updateStream($stream, 0));
+var_dump($digest->updateStream($stream));
+var_dump($digest->finalize());
+
+// chunk sizes larger than memory_limit only change the read size, not what's allocated
+rewind($stream);
+$digest = new CrcFast\Digest(CrcFast\CRC_32_ISCSI);
+var_dump($digest->updateStream($stream, null, PHP_INT_MAX));
+var_dump($digest->finalize());
+
+// invalid arguments
+try {
+    $digest->updateStream($stream, -1);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+try {
+    $digest->updateStream($stream, null, 0);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+fclose($stream);
+?>
+--EXPECT--
+int(9)
+string(16) "ae8b14860a799888"
+int(4)
+int(4)
+int(5)
+string(8) "e3069283"
+int(5)
+string(8) "e3069283"
+int(0)
+int(0)
+string(8) "e3069283"
+int(9)
+string(8) "e3069283"
+Length must be non-negative, got -1
+Chunk size must be positive, got 0
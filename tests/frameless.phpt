@@ -0,0 +1,89 @@
+--TEST--
+crc32() and hash() frameless and regular calls agree
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+// fully qualified calls with 1-3 arguments go through the frameless handlers on PHP 8.4+, dynamic calls never do
+$crc32 = 'CrcFast\crc32';
+$hash = 'CrcFast\hash';
+
+var_dump(CrcFast\crc32('123456789'), $crc32('123456789'));
+var_dump(CrcFast\crc32(''), $crc32(''));
+var_dump(CrcFast\crc32(123456789), $crc32(123456789));
+
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, '123456789'), $hash(CrcFast\CRC_32_ISCSI, '123456789'));
+var_dump(CrcFast\hash(CrcFast\CRC_64_NVME, '123456789'), $hash(CrcFast\CRC_64_NVME, '123456789'));
+var_dump(CrcFast\hash(CrcFast\CRC_32_PHP, '123456789'), $hash(CrcFast\CRC_32_PHP, '123456789'));
+var_dump(bin2hex(CrcFast\hash(CrcFast\CRC_32_ISCSI, '123456789', true)), bin2hex($hash(CrcFast\CRC_32_ISCSI, '123456789', true)));
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, '123456789', false), $hash(CrcFast\CRC_32_ISCSI, '123456789', false));
+
+// data held in a variable, and in a temporary
+$data = '123456789';
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data), CrcFast\hash(CrcFast\CRC_32_ISCSI, $data . ''));
+
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash($params, '123456789'), $hash($params, '123456789'));
+
+// the same errors either way
+foreach ([fn() => CrcFast\crc32([]), fn() => $crc32([])] as $call) {
+    try {
+        $call();
+    } catch (TypeError $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+
+foreach ([fn() => CrcFast\hash(CrcFast\CRC_32_ISCSI, []), fn() => $hash(CrcFast\CRC_32_ISCSI, [])] as $call) {
+    try {
+        $call();
+    } catch (TypeError $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+
+foreach ([fn() => CrcFast\hash('nope', '123456789'), fn() => $hash('nope', '123456789')] as $call) {
+    try {
+        $call();
+    } catch (Exception $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+
+foreach ([fn() => CrcFast\hash(12345, '123456789'), fn() => $hash(12345, '123456789')] as $call) {
+    try {
+        $call();
+    } catch (Exception $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+?>
+--EXPECT--
+int(3421780262)
+int(3421780262)
+int(0)
+int(0)
+int(3421780262)
+int(3421780262)
+string(8) "e3069283"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(16) "ae8b14860a799888"
+string(8) "181989fc"
+string(8) "181989fc"
+string(8) "e3069283"
+string(8) "e3069283"
+string(8) "e3069283"
+string(8) "e3069283"
+string(8) "e3069283"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(16) "ae8b14860a799888"
+CrcFast\crc32(): Argument #1 ($data) must be of type string, array given
+CrcFast\crc32(): Argument #1 ($data) must be of type string, array given
+CrcFast\hash(): Argument #2 ($data) must be of type string, array given
+CrcFast\hash(): Argument #2 ($data) must be of type string, array given
+Algorithm parameter must be an integer constant or CrcFast\Params object, string given
+Algorithm parameter must be an integer constant or CrcFast\Params object, string given
+Invalid algorithm constant 12345. Use CrcFast\get_supported_algorithms() to see valid values
+Invalid algorithm constant 12345. Use CrcFast\get_supported_algorithms() to see valid values
@@ -0,0 +1,129 @@
+--TEST--
+get_algorithm_info() test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$algorithms = CrcFast\get_supported_algorithms();
+$algorithms['CRC-32/PHP'] = CrcFast\CRC_32_PHP;
+
+// the descriptor table must agree with what's actually calculated
+foreach ($algorithms as $name => $algorithm) {
+    $info = CrcFast\get_algorithm_info($algorithm);
+
+    if ($info['id'] !== $algorithm) {
+        echo "FAIL: $name id is {$info['id']}\n";
+    }
+    if ($info['check'] !== CrcFast\hash_int($algorithm, '123456789')) {
+        echo "FAIL: $name check doesn't match hash_int()\n";
+    }
+    if ($info['width'] !== strlen(CrcFast\hash($algorithm, '', true)) * 8) {
+        echo "FAIL: $name width doesn't match hash()\n";
+    }
+    if (!in_array($info['hash_name'], hash_algos(), true)) {
+        echo "FAIL: $name hash_name {$info['hash_name']} isn't registered with ext/hash\n";
+    }
+    if (!is_string($info['target']) || $info['target'] === '') {
+        echo "FAIL: $name has no target\n";
+    }
+
+    // a Params object with the same parameters gives the same checksum
+    if (!$info['reverse_bytes']) {
+        $params = new CrcFast\Params(
+            $info['width'],
+            $info['poly'],
+            $info['init'],
+            $info['refin'],
+            $info['refout'],
+            $info['xorout'],
+            $info['check']
+        );
+        if (CrcFast\hash_int($params, 'hello, world') !== CrcFast\hash_int($algorithm, 'hello, world')) {
+            echo "FAIL: $name parameters don't match the algorithm\n";
+        }
+    }
+}
+echo "checked " . count($algorithms) . " algorithms\n";
+
+$info = CrcFast\get_algorithm_info(CrcFast\CRC_32_ISCSI);
+unset($info['target']);
+var_dump($info);
+
+$info = CrcFast\get_algorithm_info(CrcFast\CRC_32_PHP);
+var_dump($info['name'], $info['supported_name'], $info['reverse_bytes'], dechex($info['check']));
+
+$info = CrcFast\get_algorithm_info(CrcFast\CRC_64_NVME);
+var_dump($info['name'], sprintf('%016x', $info['poly']), sprintf('%016x', $info['check']));
+
+// 64-bit values with the top bit set are negative, as hash_int() returns them
+$info = CrcFast\get_algorithm_info(CrcFast\CRC_64_XZ);
+var_dump($info['poly'], $info['init'], $info['xorout'], $info['check'], sprintf('%016x', $info['check']));
+var_dump($info['check'] === CrcFast\hash_int(CrcFast\CRC_64_XZ, '123456789'));
+
+// CrcFast\Params objects have no id or names
+$info = CrcFast\get_algorithm_info(new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283));
+var_dump($info['id'], $info['name'], $info['supported_name'], $info['hash_name'], $info['width'], dechex($info['check']));
+
+try {
+    CrcFast\get_algorithm_info(99999);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+// the same array comes back every time, and changing a copy doesn't change it
+$algorithms = CrcFast\get_supported_algorithms();
+$algorithms['CRC-32/NOPE'] = 1;
+var_dump(count($algorithms), count(CrcFast\get_supported_algorithms()));
+var_dump(CrcFast\get_supported_algorithms() === CrcFast\get_supported_algorithms());
+?>
+--EXPECT--
+checked 20 algorithms
+array(12) {
+  ["id"]=>
+  int(10060)
+  ["name"]=>
+  string(12) "CRC-32/ISCSI"
+  ["width"]=>
+  int(32)
+  ["poly"]=>
+  int(517762881)
+  ["init"]=>
+  int(4294967295)
+  ["refin"]=>
+  bool(true)
+  ["refout"]=>
+  bool(true)
+  ["xorout"]=>
+  int(4294967295)
+  ["check"]=>
+  int(3808858755)
+  ["reverse_bytes"]=>
+  bool(false)
+  ["supported_name"]=>
+  string(12) "CRC-32/ISCSI"
+  ["hash_name"]=>
+  string(10) "crc32iscsi"
+}
+string(10) "CRC-32/PHP"
+NULL
+bool(true)
+string(8) "181989fc"
+string(11) "CRC-64/NVME"
+string(16) "ad93d23594c93659"
+string(16) "ae8b14860a799888"
+int(4823603603198064275)
+int(-1)
+int(-1)
+int(-7395533204333446662)
+string(16) "995dc9bbdf1939fa"
+bool(true)
+NULL
+NULL
+NULL
+NULL
+int(32)
+string(8) "e3069283"
+Invalid algorithm constant 99999. Use CrcFast\get_supported_algorithms() to see valid values
+int(20)
+int(19)
+bool(true)
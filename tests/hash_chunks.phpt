@@ -0,0 +1,118 @@
+--TEST--
+hash_chunks() and hash_file_chunks() test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$data = str_repeat('123456789', 1000);
+$file = tempnam(sys_get_temp_dir(), 'crc');
+file_put_contents($file, $data);
+
+$params = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+
+foreach ([CrcFast\CRC_64_NVME, CrcFast\CRC_32_ISCSI, CrcFast\CRC_32_PHP, $params] as $algorithm) {
+    foreach ([1, 7, 4096, 9000, 100000] as $chunkSize) {
+        foreach ([false, true] as $binary) {
+            $expected = array_map(fn ($part) => CrcFast\hash($algorithm, $part, $binary), str_split($data, $chunkSize));
+            $whole = CrcFast\hash($algorithm, $data, $binary);
+
+            $result = CrcFast\hash_chunks($algorithm, $data, $chunkSize, $binary);
+            if ($result !== ['chunks' => $expected, 'checksum' => $whole]) {
+                echo "hash_chunks() mismatch for chunk size $chunkSize\n";
+            }
+
+            $result = CrcFast\hash_file_chunks($algorithm, $file, $chunkSize, $binary);
+            if ($result !== ['chunks' => $expected, 'checksum' => $whole]) {
+                echo "hash_file_chunks() mismatch for chunk size $chunkSize\n";
+            }
+
+            $packed = implode('', array_map(fn ($part) => CrcFast\hash($algorithm, $part, true), str_split($data, $chunkSize)));
+            if (CrcFast\hash_chunks($algorithm, $data, $chunkSize, $binary, true)['chunks'] !== $packed
+                || CrcFast\hash_file_chunks($algorithm, $file, $chunkSize, $binary, true)['chunks'] !== $packed) {
+                echo "packed mismatch for chunk size $chunkSize\n";
+            }
+        }
+    }
+}
+
+var_dump(CrcFast\hash_chunks(CrcFast\CRC_64_NVME, '123456789', 4));
+var_dump(bin2hex(CrcFast\hash_chunks(CrcFast\CRC_32_ISCSI, '123456789', 5, packed: true)['chunks']));
+
+// other formats apply to each part and the whole, but not to packed parts
+foreach ([CrcFast\FORMAT_HEX_UPPER, CrcFast\FORMAT_BINARY_LE, CrcFast\FORMAT_BASE64, CrcFast\FORMAT_INT] as $format) {
+    foreach ([CrcFast\CRC_64_NVME, CrcFast\CRC_32_PHP, $params] as $algorithm) {
+        $expected = array_map(fn ($part) => CrcFast\hash($algorithm, $part, format: $format), str_split($data, 4096));
+        $whole = CrcFast\hash($algorithm, $data, format: $format);
+
+        if (CrcFast\hash_chunks($algorithm, $data, 4096, format: $format) !== ['chunks' => $expected, 'checksum' => $whole]) {
+            echo "hash_chunks() mismatch for format $format\n";
+        }
+        if (CrcFast\hash_file_chunks($algorithm, $file, 4096, format: $format) !== ['chunks' => $expected, 'checksum' => $whole]) {
+            echo "hash_file_chunks() mismatch for format $format\n";
+        }
+    }
+}
+$result = CrcFast\hash_chunks(CrcFast\CRC_32_ISCSI, '123456789', 5, packed: true, format: CrcFast\FORMAT_INT);
+var_dump(bin2hex($result['chunks']), $result['checksum']);
+
+// empty data has no parts, and the checksum of nothing
+var_dump(CrcFast\hash_chunks(CrcFast\CRC_32_ISCSI, '', 4));
+file_put_contents($file, '');
+var_dump(CrcFast\hash_file_chunks(CrcFast\CRC_32_ISCSI, $file, 4) === CrcFast\hash_chunks(CrcFast\CRC_32_ISCSI, '', 4));
+
+// the number of parts is capped, files are checked before they're read
+$data = str_repeat('a', 1024 * 1024 + 1);
+file_put_contents($file, $data);
+foreach (['hash_chunks' => $data, 'hash_file_chunks' => $file] as $function => $input) {
+    try {
+        ('CrcFast\\' . $function)(CrcFast\CRC_32_ISCSI, $input, 1);
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+    var_dump(count(('CrcFast\\' . $function)(CrcFast\CRC_32_ISCSI, $input, 2)['chunks']));
+}
+unlink($file);
+
+try {
+    CrcFast\hash_chunks(CrcFast\CRC_64_NVME, '123456789', 0);
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+
+try {
+    CrcFast\hash_chunks(CrcFast\CRC_64_NVME, '123456789', 4, format: 42);
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+?>
+--EXPECT--
+array(2) {
+  ["chunks"]=>
+  array(3) {
+    [0]=>
+    string(16) "29f5dbe7e2ff71d4"
+    [1]=>
+    string(16) "f3c774afe7009fd7"
+    [2]=>
+    string(16) "85894d772e0f40a7"
+  }
+  ["checksum"]=>
+  string(16) "ae8b14860a799888"
+}
+string(16) "18d12335c27e5db2"
+string(16) "18d12335c27e5db2"
+int(3808858755)
+array(2) {
+  ["chunks"]=>
+  array(0) {
+  }
+  ["checksum"]=>
+  string(8) "00000000"
+}
+bool(true)
+Too many chunks, at most 1048576 are supported. Use a larger chunk size
+int(524289)
+Too many chunks, at most 1048576 are supported. Use a larger chunk size
+int(524289)
+Chunk size must be positive, got 0
+Invalid output format 42. Use one of the CrcFast\FORMAT_* constants
@@ -0,0 +1,86 @@
+--TEST--
+ext/hash backend test
+--EXTENSIONS--
+crc_fast
+hash
+--FILE--
+<?php
+var_dump(in_array('crc64nvme', hash_algos(), true));
+var_dump(in_array('crc32iscsi', hash_algos(), true));
+
+// one-shot
+var_dump(hash('crc32iscsi', '123456789'));
+var_dump(hash('crc64nvme', '123456789'));
+var_dump(bin2hex(hash('crc64nvme', '123456789', true)));
+var_dump(hash('crc64nvme', ''));
+
+// matches the native implementations
+var_dump(hash('crc32php', '123456789') === hash('crc32', '123456789'));
+var_dump(hash('crc32isohdlc', '123456789') === hash('crc32b', '123456789'));
+var_dump(hash('crc32iscsi', '123456789') === hash('crc32c', '123456789'));
+
+// incremental
+$context = hash_init('crc64nvme');
+hash_update($context, '123');
+hash_update($context, '');
+hash_update($context, '456');
+$copy = hash_copy($context);
+hash_update($context, '789');
+var_dump(hash_final($context));
+
+// copy is independent
+hash_update($copy, '789');
+var_dump(hash_final($copy));
+
+// many updates carry on from each other, for every algorithm
+$data = str_repeat(implode('', range('a', 'z')), 400);
+foreach (CrcFast\get_supported_algorithms() as $name => $algorithm) {
+    $info = CrcFast\get_algorithm_info($algorithm);
+    $context = hash_init($info['hash_name']);
+    foreach (str_split($data, 1021) as $part) {
+        hash_update($context, $part);
+    }
+    if (hash_final($context) !== CrcFast\hash($algorithm, $data)) {
+        echo "FAIL: $name incremental mismatch\n";
+    }
+}
+
+// serialized contexts resume where they left off
+$context = hash_init('crc32iscsi');
+hash_update($context, '1234');
+$context = unserialize(serialize($context));
+hash_update($context, '56789');
+var_dump(hash_final($context));
+
+// streams
+$stream = fopen('php://memory', 'w+');
+fwrite($stream, '123456789');
+rewind($stream);
+$context = hash_init('crc64nvme');
+var_dump(hash_update_stream($context, $stream));
+var_dump(hash_final($context));
+
+fclose($stream);
+
+$tempfile = tmpfile();
+fwrite($tempfile, '123456789');
+fsync($tempfile);
+var_dump(hash_file('crc64nvme', stream_get_meta_data($tempfile)['uri']));
+fclose($tempfile);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(16) "ae8b14860a799888"
+string(16) "0000000000000000"
+bool(true)
+bool(true)
+bool(true)
+string(16) "ae8b14860a799888"
+string(16) "ae8b14860a799888"
+string(8) "e3069283"
+int(9)
+string(16) "ae8b14860a799888"
+string(16) "ae8b14860a799888"
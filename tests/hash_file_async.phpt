@@ -0,0 +1,138 @@
+--TEST--
+hash_file_async() and PendingHash test
+--EXTENSIONS--
+crc_fast
+--SKIPIF--
+<?php if (PHP_OS_FAMILY === 'Windows') die('skip notification streams are not supported on Windows'); ?>
+--FILE--
+<?php
+$tempfile = tmpfile();
+fwrite($tempfile, '123456789');
+fsync($tempfile);
+
+$path = stream_get_meta_data($tempfile)['uri'];
+
+$pending = CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, $path);
+var_dump($pending instanceof CrcFast\PendingHash);
+var_dump($pending->wait());
+var_dump($pending->isDone());
+var_dump($pending->result());
+var_dump($pending->result());
+
+// output formats
+var_dump(bin2hex(CrcFast\hash_file_async(CrcFast\CRC_64_NVME, $path, true)->result()));
+var_dump(CrcFast\hash_file_async(CrcFast\CRC_32_PHP, $path, false, CrcFast\FORMAT_BASE64)->result());
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+$pending = CrcFast\hash_file_async($params, $path);
+unset($params);
+var_dump($pending->result());
+
+// more than the pool runs at once, so some wait in the queue
+$pendings = [];
+for ($i = 0; $i < 40; $i++) {
+    $pendings[] = CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, $path);
+}
+var_dump(array_unique(array_map(fn ($pending) => $pending->result(), $pendings)));
+
+// a bigger file, waited on through the notification stream
+ftruncate($tempfile, 0);
+rewind($tempfile);
+for ($i = 0; $i < 32; $i++) {
+    fwrite($tempfile, str_repeat(chr($i), 1024 * 1024 + 7));
+}
+fsync($tempfile);
+
+$pending = CrcFast\hash_file_async(CrcFast\CRC_64_NVME, $path);
+$stream = $pending->getStream();
+var_dump($stream === $pending->getStream());
+$read = [$stream];
+$write = $except = null;
+var_dump(stream_select($read, $write, $except, 30));
+var_dump($pending->isDone());
+var_dump($pending->result() === CrcFast\hash_file(CrcFast\CRC_64_NVME, $path));
+
+// asking for the stream after it's done still wakes up straight away
+$pending = CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, $path);
+$pending->wait();
+$read = [$pending->getStream()];
+var_dump(stream_select($read, $write, $except, 0));
+
+// a zero timeout just polls
+$pending = CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, $path);
+var_dump(is_bool($pending->wait(0)));
+var_dump($pending->wait(30.0));
+
+// dropping an unfinished hash doesn't wait for the whole file
+$pending = CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, $path);
+unset($pending);
+echo "dropped\n";
+
+// including ones still waiting in the queue
+$pendings = [];
+for ($i = 0; $i < 40; $i++) {
+    $pendings[] = CrcFast\hash_file_async(CrcFast\CRC_64_NVME, $path);
+}
+unset($pendings);
+echo "dropped queued\n";
+
+try {
+    CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, $path)->wait(-1);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+fclose($tempfile);
+
+try {
+    CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, __DIR__ . '/does-not-exist.txt');
+} catch (Exception $e) {
+    echo get_class($e) . "\n";
+}
+
+try {
+    CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, 'php://memory');
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+try {
+    new CrcFast\PendingHash();
+} catch (Error $e) {
+    echo $e->getMessage() . "\n";
+}
+
+try {
+    serialize(CrcFast\hash_file_async(CrcFast\CRC_32_ISCSI, __FILE__));
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+string(8) "e3069283"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "GBmJ/A=="
+string(16) "ae8b14860a799888"
+array(1) {
+  [0]=>
+  string(8) "e3069283"
+}
+bool(true)
+int(1)
+bool(true)
+bool(true)
+int(1)
+bool(true)
+bool(true)
+dropped
+dropped queued
+Timeout must be non-negative, got -1.000000
+Exception
+File 'php://memory' is not a plain file
+Call to private CrcFast\PendingHash::__construct() from global scope
+Serialization of 'CrcFast\PendingHash' is not allowed
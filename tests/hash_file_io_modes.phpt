@@ -0,0 +1,114 @@
+--TEST--
+hash_file() I/O modes test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$tempfile = tmpfile();
+fwrite($tempfile, '123456789');
+fsync($tempfile);
+
+$path = stream_get_meta_data($tempfile)['uri'];
+
+$modes = [
+    'IO_DEFAULT' => CrcFast\IO_DEFAULT,
+    'IO_BUFFERED' => CrcFast\IO_BUFFERED,
+    'IO_MMAP' => CrcFast\IO_MMAP,
+    'IO_DIRECT' => CrcFast\IO_DIRECT,
+    'IO_URING' => CrcFast\IO_URING,
+];
+
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+
+// mmap and O_DIRECT aren't on Windows, and io_uring needs liburing, so those just have to be consistent
+foreach ($modes as $name => $mode) {
+    try {
+        $results = [
+            CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, io_mode: $mode),
+            CrcFast\hash_file(CrcFast\CRC_32_PHP, $path, io_mode: $mode),
+            bin2hex(CrcFast\hash_file(CrcFast\CRC_64_NVME, $path, true, io_mode: $mode)),
+            CrcFast\hash_file($params, $path, io_mode: $mode),
+            CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, chunk_size: 2, io_mode: $mode, queue_depth: 3),
+        ];
+        var_dump($results === ['e3069283', '181989fc', 'ae8b14860a799888', 'ae8b14860a799888', 'e3069283']);
+    } catch (Exception $e) {
+        var_dump(str_contains($e->getMessage(), 'not supported'));
+    }
+}
+
+// bigger than a chunk, with an unaligned length
+ftruncate($tempfile, 0);
+rewind($tempfile);
+for ($i = 0; $i < 5; $i++) {
+    fwrite($tempfile, str_repeat(chr($i), 1024 * 1024 + 7));
+}
+fsync($tempfile);
+
+$expected = CrcFast\hash_file(CrcFast\CRC_64_NVME, $path);
+foreach ($modes as $name => $mode) {
+    try {
+        var_dump(CrcFast\hash_file(CrcFast\CRC_64_NVME, $path, io_mode: $mode) === $expected);
+    } catch (Exception $e) {
+        var_dump(str_contains($e->getMessage(), 'not supported'));
+    }
+}
+
+// empty file
+ftruncate($tempfile, 0);
+foreach ([CrcFast\IO_BUFFERED, CrcFast\IO_DIRECT] as $mode) {
+    var_dump(CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, io_mode: $mode));
+}
+
+// invalid arguments
+foreach ([[-1, null], [5, null], [CrcFast\IO_BUFFERED, 0], [CrcFast\IO_BUFFERED, 257]] as [$mode, $depth]) {
+    try {
+        CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, io_mode: $mode, queue_depth: $depth);
+    } catch (Exception $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+
+// buffers are sized from chunk_size up front, so it's capped for the modes that read into them
+foreach ($modes as $name => $mode) {
+    try {
+        $result = CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, chunk_size: 64 * 1024 * 1024 + 1, io_mode: $mode);
+    } catch (Exception $e) {
+        $result = str_contains($e->getMessage(), 'not supported') ? 'not supported' : $e->getMessage();
+    }
+    echo "$name: $result\n";
+}
+var_dump(CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, chunk_size: 64 * 1024 * 1024, io_mode: CrcFast\IO_BUFFERED));
+
+fclose($tempfile);
+
+// only plain files
+try {
+    CrcFast\hash_file(CrcFast\CRC_32_ISCSI, 'php://memory', io_mode: CrcFast\IO_BUFFERED);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECTF--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+string(8) "00000000"
+string(8) "00000000"
+Invalid I/O mode -1. Use one of the CrcFast\IO_* constants
+Invalid I/O mode 5. Use one of the CrcFast\IO_* constants
+Queue depth must be between 1 and 256, got 0
+Queue depth must be between 1 and 256, got 257
+IO_DEFAULT: 00000000
+IO_BUFFERED: Chunk size must be no larger than 67108864 bytes for this I/O mode, got 67108865
+IO_MMAP: %r(00000000|not supported)%r
+IO_DIRECT: %r(Chunk size must be no larger than 67108864 bytes for this I/O mode, got 67108865|not supported)%r
+IO_URING: %r(Chunk size must be no larger than 67108864 bytes for this I/O mode, got 67108865|not supported)%r
+string(8) "00000000"
+File 'php://memory' is not a plain file
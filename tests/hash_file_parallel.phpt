@@ -0,0 +1,76 @@
+--TEST--
+hash_file_parallel() test
+--EXTENSIONS--
+crc_fast
+--INI--
+memory_limit=256M
+--FILE--
+<?php
+$tempfile = tmpfile();
+fwrite($tempfile, '123456789');
+fsync($tempfile);
+
+$path = stream_get_meta_data($tempfile)['uri'];
+
+// small files are checksummed on the calling thread
+var_dump(CrcFast\hash_file_parallel(CrcFast\CRC_32_ISCSI, $path));
+var_dump(bin2hex(CrcFast\hash_file_parallel(CrcFast\CRC_64_NVME, $path, true, 4)));
+
+// large enough to be split into several ranges, with an uneven remainder
+ftruncate($tempfile, 0);
+rewind($tempfile);
+for ($i = 0; $i < 50; $i++) {
+    fwrite($tempfile, str_repeat(chr($i), 1024 * 1024 + 7));
+}
+fsync($tempfile);
+
+foreach ([CrcFast\CRC_32_ISCSI, CrcFast\CRC_32_PHP, CrcFast\CRC_64_NVME] as $algorithm) {
+    var_dump(CrcFast\hash_file_parallel($algorithm, $path, false, 3) === CrcFast\hash_file($algorithm, $path));
+    var_dump(CrcFast\hash_file_parallel($algorithm, $path) === CrcFast\hash_file($algorithm, $path));
+}
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash_file_parallel($params, $path, false, 3) === CrcFast\hash_file(CrcFast\CRC_64_NVME, $path));
+
+// output formats
+var_dump(CrcFast\hash_file_parallel(CrcFast\CRC_64_NVME, $path, format: CrcFast\FORMAT_BASE64)
+    === CrcFast\hash_file(CrcFast\CRC_64_NVME, $path, format: CrcFast\FORMAT_BASE64));
+var_dump(CrcFast\hash_file_parallel(CrcFast\CRC_32_ISCSI, $path, false, 2, CrcFast\FORMAT_INT)
+    === CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, format: CrcFast\FORMAT_INT));
+
+// empty file
+ftruncate($tempfile, 0);
+var_dump(CrcFast\hash_file_parallel(CrcFast\CRC_32_ISCSI, $path, false, 8));
+
+// invalid thread count
+try {
+    CrcFast\hash_file_parallel(CrcFast\CRC_32_ISCSI, $path, false, 0);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+fclose($tempfile);
+
+// only plain files
+try {
+    CrcFast\hash_file_parallel(CrcFast\CRC_32_ISCSI, 'php://memory');
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECT--
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+string(8) "00000000"
+Thread count must be between 1 and 1024, got 0
+File 'php://memory' is not a plain file
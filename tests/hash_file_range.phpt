@@ -0,0 +1,77 @@
+--TEST--
+hash_file_range() test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$tempfile = tmpfile();
+fwrite($tempfile, '123456789');
+fsync($tempfile);
+
+$path = stream_get_meta_data($tempfile)['uri'];
+
+// the whole file
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 0));
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_64_NVME, $path, 0, 9));
+
+// ranges at the start, middle, and end
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 0, 5));
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 2, 6));
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_PHP, $path, 2, 6));
+var_dump(bin2hex(CrcFast\hash_file_range(CrcFast\CRC_64_NVME, $path, 4, null, true)));
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 2, 6, false, CrcFast\FORMAT_HEX_UPPER));
+
+// matches hashing the same bytes in memory, and combines back into the whole
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_64_NVME, $path, 3, 4) === CrcFast\hash(CrcFast\CRC_64_NVME, '4567'));
+var_dump(CrcFast\combine(
+    CrcFast\CRC_32_ISCSI,
+    CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 0, 5),
+    CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 5),
+    4
+));
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash_file_range($params, $path, 4, 5));
+
+// empty ranges, including at the very end
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 3, 0));
+var_dump(CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, 9));
+
+// out of bounds
+foreach ([[-1, null], [0, -1], [10, null], [5, 5], [0, PHP_INT_MAX]] as [$offset, $length]) {
+    try {
+        CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, $path, $offset, $length);
+    } catch (Exception $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+
+fclose($tempfile);
+
+// only plain files
+try {
+    CrcFast\hash_file_range(CrcFast\CRC_32_ISCSI, 'php://memory', 0);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECTF--
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "18d12335"
+string(8) "0ac97f1b"
+string(8) "cec693fc"
+string(16) "f87dc887176ce667"
+string(8) "0AC97F1B"
+bool(true)
+string(8) "e3069283"
+string(16) "f87dc887176ce667"
+string(8) "00000000"
+string(8) "00000000"
+Offset must be non-negative, got -1
+Length must be non-negative, got -1
+Range of 0 bytes at offset 10 is beyond the end of file '%s' (9 bytes)
+Range of 5 bytes at offset 5 is beyond the end of file '%s' (9 bytes)
+Range of %d bytes at offset 0 is beyond the end of file '%s' (9 bytes)
+File 'php://memory' is not a plain file
@@ -0,0 +1,65 @@
+--TEST--
+hash_file() with stream wrappers and chunk_size test
+--EXTENSIONS--
+crc_fast
+--INI--
+allow_url_fopen=1
+memory_limit=32M
+--FILE--
+<?php
+$tempfile = tmpfile();
+fwrite($tempfile, '123456789');
+fsync($tempfile);
+
+$path = stream_get_meta_data($tempfile)['uri'];
+
+// file:// is still a plain file
+var_dump(CrcFast\hash_file(CrcFast\CRC_32_ISCSI, 'file://' . $path));
+
+// explicit chunk sizes, smaller and larger than the file
+var_dump(CrcFast\hash_file(CrcFast\CRC_32_ISCSI, $path, false, 2));
+var_dump(CrcFast\hash_file(CrcFast\CRC_64_NVME, $path, false, 4096));
+
+// chunk sizes past memory_limit only change the read size, not what's allocated
+var_dump(CrcFast\hash_file(CrcFast\CRC_32_ISCSI, 'data://text/plain,123456789', false, 48 * 1024 * 1024));
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash_file($params, $path, false, 3));
+
+// data://
+var_dump(CrcFast\hash_file(CrcFast\CRC_32_ISCSI, 'data://text/plain;base64,' . base64_encode('123456789')));
+
+// php://filter
+file_put_contents($path, 'nop');
+var_dump(
+    CrcFast\hash_file(CrcFast\CRC_64_NVME, 'php://filter/read=string.rot13/resource=' . $path)
+    === CrcFast\hash(CrcFast\CRC_64_NVME, 'abc')
+);
+
+fclose($tempfile);
+
+// invalid chunk size
+try {
+    CrcFast\hash_file(CrcFast\CRC_32_ISCSI, 'data://text/plain,123456789', false, 0);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+// missing file
+try {
+    CrcFast\hash_file(CrcFast\CRC_32_ISCSI, __DIR__ . '/does-not-exist.txt', false, 1024);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECTF--
+string(8) "e3069283"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "e3069283"
+bool(true)
+Chunk size must be positive, got 0
+Failed to open file '%sdoes-not-exist.txt'
@@ -0,0 +1,98 @@
+--TEST--
+hash_files() test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$dir = __DIR__ . '/hash_files_tmp';
+@mkdir($dir);
+
+$paths = [];
+for ($i = 0; $i < 50; $i++) {
+    $paths[$i] = "$dir/$i.txt";
+    file_put_contents($paths[$i], str_repeat((string)$i, $i * 1000));
+}
+file_put_contents("$dir/check.txt", '123456789');
+
+// matches hash_file() for every file, however many threads
+foreach ([null, 1, 3, 64] as $threads) {
+    $results = CrcFast\hash_files(CrcFast\CRC_64_NVME, $paths, $threads === null ? [] : ['threads' => $threads]);
+    $expected = [];
+    foreach ($paths as $path) {
+        $expected[$path] = CrcFast\hash_file(CrcFast\CRC_64_NVME, $path);
+    }
+    var_dump($results === $expected);
+}
+
+// output formats
+$check = ["$dir/check.txt"];
+var_dump(CrcFast\hash_files(CrcFast\CRC_32_ISCSI, $check)["$dir/check.txt"]);
+var_dump(CrcFast\hash_files(CrcFast\CRC_32_PHP, $check)["$dir/check.txt"]);
+var_dump(bin2hex(CrcFast\hash_files(CrcFast\CRC_64_NVME, $check, ['binary' => true])["$dir/check.txt"]));
+var_dump(CrcFast\hash_files(CrcFast\CRC_32_ISCSI, $check, ['format' => CrcFast\FORMAT_BASE64])["$dir/check.txt"]);
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash_files($params, $check)["$dir/check.txt"]);
+
+// no files
+var_dump(CrcFast\hash_files(CrcFast\CRC_32_ISCSI, []));
+
+// failures are returned per file, without stopping the others
+ini_set('open_basedir', $dir);
+$results = CrcFast\hash_files(CrcFast\CRC_32_ISCSI, [
+    "$dir/check.txt",
+    "$dir/missing.txt",
+    __FILE__,
+    'php://memory',
+]);
+foreach ($results as $path => $result) {
+    echo str_replace($dir, 'DIR', $path), ': ', $result instanceof Exception ? str_replace([$dir, __FILE__], ['DIR', 'FILE'], $result->getMessage()) : $result, "\n";
+}
+
+// invalid arguments
+foreach ([
+    [['threads' => 0], $check],
+    [['threads' => '2'], $check],
+    [['bogus' => true], $check],
+    [['format' => 99], $check],
+    [[], [1 => 42]],
+    [[], ['a' => '']],
+] as [$options, $paths]) {
+    try {
+        CrcFast\hash_files(CrcFast\CRC_32_ISCSI, $paths, $options);
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+}
+?>
+--CLEAN--
+<?php
+$dir = __DIR__ . '/hash_files_tmp';
+foreach (glob("$dir/*") ?: [] as $file) {
+    unlink($file);
+}
+@rmdir($dir);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+string(8) "e3069283"
+string(8) "181989fc"
+string(16) "ae8b14860a799888"
+string(8) "4waSgw=="
+string(16) "ae8b14860a799888"
+array(0) {
+}
+DIR/check.txt: e3069283
+DIR/missing.txt: Failed to open file 'DIR/missing.txt'
+FILE: File 'FILE' is not within the allowed path(s)
+php://memory: File 'php://memory' is not a plain file
+Thread count must be between 1 and 1024, got 0
+Invalid option "threads", expected "threads" (int), "binary" (bool), or "format" (?int)
+Invalid option "bogus", expected "threads" (int), "binary" (bool), or "format" (?int)
+Invalid output format 99. Use one of the CrcFast\FORMAT_* constants
+All paths must be non-empty strings, element 1 is not
+All paths must be non-empty strings, element "a" is not
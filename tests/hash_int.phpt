@@ -0,0 +1,51 @@
+--TEST--
+hash_int() and Digest::finalizeInt() test
+--EXTENSIONS--
+crc_fast
+--SKIPIF--
+<?php if (PHP_INT_SIZE < 8) die('skip 64-bit only'); ?>
+--FILE--
+<?php
+// CRC-32 results are non-negative
+var_dump(CrcFast\hash_int(CrcFast\CRC_32_ISCSI, '123456789'));
+var_dump(CrcFast\hash_int(CrcFast\CRC_32_ISO_HDLC, '123456789') === CrcFast\crc32('123456789'));
+var_dump(CrcFast\hash_int(CrcFast\CRC_32_PHP, '123456789'));
+
+// CRC-64 results use all 64 bits
+$int = CrcFast\hash_int(CrcFast\CRC_64_NVME, '123456789');
+var_dump($int);
+var_dump(sprintf('%016x', $int));
+var_dump(pack('J', $int) === CrcFast\hash(CrcFast\CRC_64_NVME, '123456789', true));
+
+// every algorithm matches its hex output
+foreach (CrcFast\get_supported_algorithms() as $name => $algorithm) {
+    $hex = CrcFast\hash($algorithm, 'hello world');
+    if (sprintf('%0' . strlen($hex) . 'x', CrcFast\hash_int($algorithm, 'hello world')) !== $hex) {
+        echo "mismatch for $name\n";
+    }
+}
+
+// custom parameters
+$params = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+var_dump(CrcFast\hash_int($params, '123456789'));
+
+// Digest
+$digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+$digest->update('1234')->update('56789');
+var_dump($digest->finalizeInt() === $int);
+var_dump((new CrcFast\Digest(CrcFast\CRC_32_PHP))->update('123456789')->finalizeInt());
+var_dump((new CrcFast\Digest($params))->update('123456789')->finalizeInt());
+var_dump((new CrcFast\Digest(CrcFast\CRC_64_NVME))->finalizeInt());
+?>
+--EXPECT--
+int(3808858755)
+bool(true)
+int(404326908)
+int(-5869575123413395320)
+string(16) "ae8b14860a799888"
+bool(true)
+int(3808858755)
+bool(true)
+int(404326908)
+int(3808858755)
+int(0)
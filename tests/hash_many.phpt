@@ -0,0 +1,84 @@
+--TEST--
+hash_many() test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+// keys are preserved
+var_dump(CrcFast\hash_many(CrcFast\CRC_32_ISCSI, ['a' => '123456789', 5 => '', 'c' => '1234']));
+
+// matches hash() for every algorithm, in both output formats
+$data = ['', '1', '123456789', str_repeat('x', 1000)];
+$mismatches = 0;
+foreach (CrcFast\get_supported_algorithms() + ['CRC-32/PHP' => CrcFast\CRC_32_PHP] as $name => $algorithm) {
+    foreach ([false, true] as $binary) {
+        $expected = array_map(fn ($item) => CrcFast\hash($algorithm, $item, $binary), $data);
+        if (CrcFast\hash_many($algorithm, $data, $binary) !== $expected) {
+            echo "Mismatch for $name\n";
+            $mismatches++;
+        }
+    }
+    foreach ([CrcFast\FORMAT_HEX_UPPER, CrcFast\FORMAT_BINARY_LE, CrcFast\FORMAT_BASE64, CrcFast\FORMAT_INT] as $format) {
+        $expected = array_map(fn ($item) => CrcFast\hash($algorithm, $item, format: $format), $data);
+        if (CrcFast\hash_many($algorithm, $data, format: $format) !== $expected) {
+            echo "Mismatch for $name in format $format\n";
+            $mismatches++;
+        }
+    }
+}
+var_dump($mismatches);
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash_many($params, ['123456789']));
+
+// empty input
+var_dump(CrcFast\hash_many(CrcFast\CRC_64_NVME, []));
+
+// non-string elements
+try {
+    CrcFast\hash_many(CrcFast\CRC_64_NVME, ['123456789', 42]);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+try {
+    CrcFast\hash_many(CrcFast\CRC_64_NVME, ['a' => null]);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+// invalid algorithm
+try {
+    CrcFast\hash_many(99999, ['123456789']);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+// invalid format
+try {
+    CrcFast\hash_many(CrcFast\CRC_64_NVME, ['123456789'], format: 42);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECT--
+array(3) {
+  ["a"]=>
+  string(8) "e3069283"
+  [5]=>
+  string(8) "00000000"
+  ["c"]=>
+  string(8) "f63af4ee"
+}
+int(0)
+array(1) {
+  [0]=>
+  string(16) "ae8b14860a799888"
+}
+array(0) {
+}
+All data elements must be strings, element 1 is int
+All data elements must be strings, element "a" is null
+Invalid algorithm constant 99999. Use CrcFast\get_supported_algorithms() to see valid values
+Invalid output format 42. Use one of the CrcFast\FORMAT_* constants
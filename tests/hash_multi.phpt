@@ -0,0 +1,121 @@
+--TEST--
+hash_multi() and MultiDigest test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$params = new CrcFast\Params(32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xCBF43926);
+
+$algorithms = [
+    'crc32c' => CrcFast\CRC_32_ISCSI,
+    'crc64nvme' => CrcFast\CRC_64_NVME,
+    'zip' => $params,
+    CrcFast\CRC_32_PHP,
+];
+
+// one-shot
+var_dump(CrcFast\hash_multi($algorithms, '123456789'));
+var_dump(bin2hex(CrcFast\hash_multi([CrcFast\CRC_64_NVME], '123456789', true)[0]));
+
+// larger than a single chunk matches hash()
+$data = str_repeat('0123456789abcdef', 20000);
+$results = CrcFast\hash_multi($algorithms, $data);
+var_dump($results['crc32c'] === CrcFast\hash(CrcFast\CRC_32_ISCSI, $data));
+var_dump($results['crc64nvme'] === CrcFast\hash(CrcFast\CRC_64_NVME, $data));
+var_dump($results['zip'] === CrcFast\hash(CrcFast\CRC_32_ISO_HDLC, $data));
+var_dump($results[0] === CrcFast\hash(CrcFast\CRC_32_PHP, $data));
+
+// streaming
+$digest = new CrcFast\MultiDigest($algorithms);
+$digest->update('1234')->update('56789');
+var_dump($digest->finalize());
+
+var_dump($digest->finalizeReset() === $digest->update('123456789')->finalize());
+$digest->reset();
+var_dump($digest->finalize()['crc64nvme']);
+
+// output formats
+var_dump(CrcFast\hash_multi($algorithms, '123456789', format: CrcFast\FORMAT_INT));
+$digest = new CrcFast\MultiDigest([CrcFast\CRC_32_ISCSI, CrcFast\CRC_64_NVME]);
+var_dump($digest->update('123456789')->finalize(format: CrcFast\FORMAT_BASE64));
+var_dump($digest->finalizeReset(format: CrcFast\FORMAT_HEX_UPPER));
+
+try {
+    $digest->finalize(format: -1);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+// errors
+try {
+    CrcFast\hash_multi([], '123456789');
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+try {
+    new CrcFast\MultiDigest([CrcFast\CRC_32_ISCSI, 99999]);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+
+try {
+    CrcFast\hash_multi([CrcFast\CRC_32_ISCSI, 'nope'], '123456789');
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECT--
+array(4) {
+  ["crc32c"]=>
+  string(8) "e3069283"
+  ["crc64nvme"]=>
+  string(16) "ae8b14860a799888"
+  ["zip"]=>
+  string(8) "cbf43926"
+  [0]=>
+  string(8) "181989fc"
+}
+string(16) "ae8b14860a799888"
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+array(4) {
+  ["crc32c"]=>
+  string(8) "e3069283"
+  ["crc64nvme"]=>
+  string(16) "ae8b14860a799888"
+  ["zip"]=>
+  string(8) "cbf43926"
+  [0]=>
+  string(8) "181989fc"
+}
+bool(true)
+string(16) "0000000000000000"
+array(4) {
+  ["crc32c"]=>
+  int(3808858755)
+  ["crc64nvme"]=>
+  int(-5869575123413395320)
+  ["zip"]=>
+  int(3421780262)
+  [0]=>
+  int(404326908)
+}
+array(2) {
+  [0]=>
+  string(8) "4waSgw=="
+  [1]=>
+  string(12) "rosUhgp5mIg="
+}
+array(2) {
+  [0]=>
+  string(8) "E3069283"
+  [1]=>
+  string(16) "AE8B14860A799888"
+}
+Invalid output format -1. Use one of the CrcFast\FORMAT_* constants
+Algorithms array cannot be empty
+Invalid algorithm constant 99999. Use CrcFast\get_supported_algorithms() to see valid values
+Algorithm parameter must be an integer constant or CrcFast\Params object, string given
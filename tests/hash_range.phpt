@@ -0,0 +1,66 @@
+--TEST--
+hash() and Digest::update() offset and length test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$data = 'header:123456789:trailer';
+
+// hash() over a slice matches hashing the substring
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, offset: 7, length: 9));
+var_dump(CrcFast\hash(CrcFast\CRC_64_NVME, $data, false, null, 7, 9));
+var_dump(CrcFast\hash(CrcFast\CRC_32_PHP, $data, offset: 7, length: 9));
+var_dump(bin2hex(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, true, null, 7, 9)));
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, offset: 7) === CrcFast\hash(CrcFast\CRC_32_ISCSI, substr($data, 7)));
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, offset: 0) === CrcFast\hash(CrcFast\CRC_32_ISCSI, $data));
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\hash($params, $data, offset: 7, length: 9));
+
+// empty slices
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, offset: 3, length: 0));
+var_dump(CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, offset: strlen($data)));
+
+// Digest::update() over slices
+$digest = new CrcFast\Digest(CrcFast\CRC_32_ISCSI);
+$digest->update($data, 7, 5)->update($data, 12, 4);
+var_dump($digest->finalize());
+
+$digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+$digest->update('xx1234', 2)->update('56789');
+var_dump($digest->finalize());
+
+// out of bounds
+foreach ([[-1, null], [0, -1], [25, null], [20, 5], [0, PHP_INT_MAX]] as [$offset, $length]) {
+    try {
+        CrcFast\hash(CrcFast\CRC_32_ISCSI, $data, offset: $offset, length: $length);
+    } catch (Exception $e) {
+        echo $e->getMessage() . "\n";
+    }
+}
+
+try {
+    $digest->update($data, 30);
+} catch (Exception $e) {
+    echo $e->getMessage() . "\n";
+}
+?>
+--EXPECTF--
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+string(8) "181989fc"
+string(8) "e3069283"
+bool(true)
+bool(true)
+string(16) "ae8b14860a799888"
+string(8) "00000000"
+string(8) "00000000"
+string(8) "e3069283"
+string(16) "ae8b14860a799888"
+Offset must be non-negative, got -1
+Length must be non-negative, got -1
+Range of 0 bytes at offset 25 is beyond the end of the data (24 bytes)
+Range of 5 bytes at offset 20 is beyond the end of the data (24 bytes)
+Range of %d bytes at offset 0 is beyond the end of the data (24 bytes)
+Range of 0 bytes at offset 30 is beyond the end of the data (24 bytes)
@@ -0,0 +1,96 @@
+--TEST--
+Output format test
+--EXTENSIONS--
+crc_fast
+--SKIPIF--
+<?php if (PHP_INT_SIZE < 8) die('skip 64-bit only'); ?>
+--FILE--
+<?php
+$formats = [
+    'hex' => CrcFast\FORMAT_HEX,
+    'HEX' => CrcFast\FORMAT_HEX_UPPER,
+    'binary' => CrcFast\FORMAT_BINARY,
+    'binary-le' => CrcFast\FORMAT_BINARY_LE,
+    'base64' => CrcFast\FORMAT_BASE64,
+    'int' => CrcFast\FORMAT_INT,
+];
+
+foreach ([CrcFast\CRC_64_NVME, CrcFast\CRC_32_ISCSI, CrcFast\CRC_32_PHP] as $algorithm) {
+    foreach ($formats as $name => $format) {
+        $result = CrcFast\hash($algorithm, '123456789', format: $format);
+        $binary = in_array($format, [CrcFast\FORMAT_BINARY, CrcFast\FORMAT_BINARY_LE], true);
+        echo $name, ': ', $binary ? bin2hex($result) : var_export($result, true), "\n";
+    }
+}
+
+// $format overrides $binary
+var_dump(CrcFast\hash(CrcFast\CRC_64_NVME, '123456789', true, CrcFast\FORMAT_HEX));
+var_dump(CrcFast\hash(CrcFast\CRC_64_NVME, '123456789', true, null) === hex2bin('ae8b14860a799888'));
+
+// hash_file
+$file = tempnam(sys_get_temp_dir(), 'crc');
+file_put_contents($file, '123456789');
+var_dump(CrcFast\hash_file(CrcFast\CRC_64_NVME, $file, format: CrcFast\FORMAT_BASE64));
+var_dump(CrcFast\hash_file(CrcFast\CRC_64_NVME, $file, chunk_size: 4, format: CrcFast\FORMAT_HEX_UPPER));
+unlink($file);
+
+// combine
+var_dump(CrcFast\combine(
+    CrcFast\CRC_64_NVME,
+    CrcFast\hash(CrcFast\CRC_64_NVME, '1234'),
+    CrcFast\hash(CrcFast\CRC_64_NVME, '56789'),
+    5,
+    format: CrcFast\FORMAT_BASE64,
+));
+
+// Digest
+$digest = (new CrcFast\Digest(CrcFast\CRC_32_ISCSI))->update('123456789');
+var_dump($digest->finalize(format: CrcFast\FORMAT_BASE64));
+var_dump(bin2hex($digest->finalize(format: CrcFast\FORMAT_BINARY_LE)));
+var_dump($digest->finalizeReset(format: CrcFast\FORMAT_INT));
+var_dump($digest->finalize(format: CrcFast\FORMAT_HEX_UPPER));
+
+// custom parameters
+$params = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+var_dump(CrcFast\hash($params, '123456789', format: CrcFast\FORMAT_BASE64));
+
+// invalid formats
+foreach ([-1, 6] as $format) {
+    try {
+        CrcFast\hash(CrcFast\CRC_64_NVME, '123456789', format: $format);
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+}
+?>
+--EXPECT--
+hex: 'ae8b14860a799888'
+HEX: 'AE8B14860A799888'
+binary: ae8b14860a799888
+binary-le: 8898790a86148bae
+base64: 'rosUhgp5mIg='
+int: -5869575123413395320
+hex: 'e3069283'
+HEX: 'E3069283'
+binary: e3069283
+binary-le: 839206e3
+base64: '4waSgw=='
+int: 3808858755
+hex: '181989fc'
+HEX: '181989FC'
+binary: 181989fc
+binary-le: fc891918
+base64: 'GBmJ/A=='
+int: 404326908
+string(16) "ae8b14860a799888"
+bool(true)
+string(12) "rosUhgp5mIg="
+string(16) "AE8B14860A799888"
+string(12) "rosUhgp5mIg="
+string(8) "4waSgw=="
+string(8) "839206e3"
+int(3808858755)
+string(8) "00000000"
+string(8) "4waSgw=="
+Invalid output format -1. Use one of the CrcFast\FORMAT_* constants
+Invalid output format 6. Use one of the CrcFast\FORMAT_* constants
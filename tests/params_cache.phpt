@@ -0,0 +1,72 @@
+--TEST--
+Params cache test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$before = CrcFast\get_params_cache_stats();
+var_dump(array_keys($before));
+
+$first = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+$second = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+
+$after = CrcFast\get_params_cache_stats();
+var_dump($after['misses'] - $before['misses']);
+var_dump($after['hits'] - $before['hits']);
+var_dump($after['entries'] - $before['entries']);
+
+// shared keys behave exactly like freshly generated ones
+var_dump($first->getKeys() === $second->getKeys());
+var_dump(CrcFast\hash($second, '123456789'));
+unset($first);
+var_dump(CrcFast\hash($second, '123456789'));
+
+// a cached entry still validates the check value
+try {
+    new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0x12345678);
+} catch (Exception $e) {
+    echo "validation failed\n";
+}
+
+// different parameters get their own entry
+new CrcFast\Params(32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xCBF43926);
+$last = CrcFast\get_params_cache_stats();
+var_dump($last['misses'] - $after['misses']);
+var_dump($last['hits'] - $after['hits']);
+
+// explicit keys bypass the cache
+new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283, $second->getKeys());
+var_dump(CrcFast\get_params_cache_stats() === $last);
+
+// unserializing a Digest with custom parameters shares the cached keys too
+$digest = new CrcFast\Digest($second);
+$digest->update('1234');
+$serialized = serialize($digest);
+$digest = unserialize($serialized);
+$digest->update('56789');
+var_dump($digest->finalize());
+$stats = CrcFast\get_params_cache_stats();
+var_dump($stats['misses'] - $last['misses'], $stats['hits'] - $last['hits']);
+?>
+--EXPECT--
+array(3) {
+  [0]=>
+  string(4) "hits"
+  [1]=>
+  string(6) "misses"
+  [2]=>
+  string(7) "entries"
+}
+int(1)
+int(1)
+int(1)
+bool(true)
+string(8) "e3069283"
+string(8) "e3069283"
+validation failed
+int(1)
+int(1)
+bool(true)
+string(8) "e3069283"
+int(0)
+int(1)
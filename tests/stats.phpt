@@ -0,0 +1,92 @@
+--TEST--
+get_stats() and reset_stats() test
+--EXTENSIONS--
+crc_fast
+--INI--
+crc_fast.stats=1
+crc_fast.stats_timing=1
+--FILE--
+<?php
+$stats = CrcFast\get_stats();
+var_dump($stats['enabled'], $stats['timing'], $stats['calls'], $stats['algorithms']);
+
+CrcFast\hash(CrcFast\CRC_32_ISCSI, '123456789');
+CrcFast\hash_int(CrcFast\CRC_32_ISCSI, '12345');
+CrcFast\crc32('');
+CrcFast\hash_many(CrcFast\CRC_64_NVME, ['a', 'bb', 'ccc']);
+(new CrcFast\Digest(CrcFast\CRC_64_NVME))->update(str_repeat('x', 1024));
+hash('crc64nvme', '123456789');
+CrcFast\hash_multi([CrcFast\CRC_32_ISCSI, CrcFast\CRC_64_NVME], '1234');
+
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+CrcFast\hash($params, '123456789');
+
+// counted on the worker threads, and still there after they've exited
+$tempfile1 = tmpfile();
+$tempfile2 = tmpfile();
+fwrite($tempfile1, '123456789');
+fwrite($tempfile2, '123456789');
+fflush($tempfile1);
+fflush($tempfile2);
+CrcFast\hash_files(CrcFast\CRC_32_ISCSI, [
+    stream_get_meta_data($tempfile1)['uri'],
+    stream_get_meta_data($tempfile2)['uri'],
+], ['threads' => 2]);
+
+$stats = CrcFast\get_stats();
+var_dump($stats['calls'], $stats['bytes'], $stats['ns'] > 0);
+
+foreach ($stats['algorithms'] as $algorithm => $entries) {
+    foreach ($entries as $entry => $counters) {
+        echo "$algorithm $entry {$counters['calls']} {$counters['bytes']}\n";
+    }
+}
+
+var_dump(count($stats['histogram']), array_filter($stats['histogram']));
+
+CrcFast\reset_stats();
+$stats = CrcFast\get_stats();
+var_dump($stats['calls'], $stats['bytes'], $stats['algorithms'], array_sum($stats['histogram']));
+
+CrcFast\hash(CrcFast\CRC_32_ISCSI, '123456789');
+var_dump(CrcFast\get_stats()['algorithms']['CRC-32/ISCSI']['hash']['calls']);
+?>
+--EXPECT--
+bool(true)
+bool(true)
+int(0)
+array(0) {
+}
+int(13)
+int(1088)
+bool(true)
+CRC-32/ISCSI hash 2 14
+CRC-32/ISCSI hash_multi 1 4
+CRC-32/ISCSI hash_files 2 18
+CRC-32/ISO-HDLC crc32 1 0
+CRC-64/NVME hash_many 3 6
+CRC-64/NVME hash_multi 1 4
+CRC-64/NVME digest 1 1024
+CRC-64/NVME ext_hash 1 9
+custom hash 1 9
+int(32)
+array(6) {
+  [0]=>
+  int(1)
+  [1]=>
+  int(1)
+  [2]=>
+  int(2)
+  [4]=>
+  int(3)
+  [8]=>
+  int(5)
+  [1024]=>
+  int(1)
+}
+int(0)
+int(0)
+array(0) {
+}
+int(0)
+int(1)
@@ -0,0 +1,24 @@
+--TEST--
+get_stats() with crc_fast.stats off test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+CrcFast\hash(CrcFast\CRC_32_ISCSI, '123456789');
+CrcFast\crc32('123456789');
+
+$stats = CrcFast\get_stats();
+var_dump($stats['enabled'], $stats['timing'], $stats['calls'], $stats['bytes'], $stats['algorithms'], array_sum($stats['histogram']));
+
+CrcFast\reset_stats();
+var_dump(CrcFast\get_stats()['calls']);
+?>
+--EXPECT--
+bool(false)
+bool(false)
+int(0)
+int(0)
+array(0) {
+}
+int(0)
+int(0)
@@ -0,0 +1,78 @@
+--TEST--
+crcfast.* stream filter test
+--EXTENSIONS--
+crc_fast
+--FILE--
+<?php
+$source = fopen('php://memory', 'w+');
+fwrite($source, str_repeat('123456789', 1000));
+rewind($source);
+
+// read filter, checksums while copying
+$digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+stream_filter_append($source, 'crcfast.crc64nvme', STREAM_FILTER_READ, $digest);
+
+$destination = fopen('php://memory', 'w+');
+var_dump(stream_copy_to_stream($source, $destination));
+var_dump($digest->finalize());
+var_dump(CrcFast\hash(CrcFast\CRC_64_NVME, str_repeat('123456789', 1000)));
+
+// data passes through untouched
+rewind($destination);
+var_dump(stream_get_contents($destination) === str_repeat('123456789', 1000));
+
+// write filter, with any Digest including custom parameters
+$params = new CrcFast\Params(32, 0x1EDC6F41, 0xFFFFFFFF, true, true, 0xFFFFFFFF, 0xE3069283);
+$digest = new CrcFast\Digest($params);
+$stream = fopen('php://memory', 'w+');
+$filter = stream_filter_append($stream, 'crcfast.digest', STREAM_FILTER_WRITE, $digest);
+fwrite($stream, '1234');
+var_dump($digest->finalize());
+fwrite($stream, '56789');
+var_dump($digest->finalize());
+
+// no longer fed once removed
+stream_filter_remove($filter);
+fwrite($stream, 'more');
+var_dump($digest->finalize());
+
+// a Digest constructed again while attached stops the filter if it fails, or changes algorithm
+$digest = new CrcFast\Digest(CrcFast\CRC_64_NVME);
+$stream = fopen('php://memory', 'w+');
+stream_filter_append($stream, 'crcfast.crc64nvme', STREAM_FILTER_WRITE, $digest);
+try {
+    $digest->__construct(99999);
+} catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+}
+var_dump(fwrite($stream, '123'));
+$digest->__construct(CrcFast\CRC_32_ISCSI);
+var_dump(fwrite($stream, '123'));
+$digest->__construct(CrcFast\CRC_64_NVME);
+var_dump(fwrite($stream, '123456789'), $digest->finalize());
+
+// invalid parameters
+var_dump(@stream_filter_append($stream, 'crcfast.crc64nvme', STREAM_FILTER_READ));
+var_dump(@stream_filter_append($stream, 'crcfast.crc32iscsi', STREAM_FILTER_READ, new CrcFast\Digest(CrcFast\CRC_64_NVME)));
+var_dump(@stream_filter_append($stream, 'crcfast.unknown', STREAM_FILTER_READ, new CrcFast\Digest(CrcFast\CRC_64_NVME)));
+?>
+--EXPECTF--
+int(9000)
+string(16) "96641767b0a579b7"
+string(16) "96641767b0a579b7"
+bool(true)
+string(8) "f63af4ee"
+string(8) "e3069283"
+string(8) "e3069283"
+Invalid algorithm constant 99999. Use CrcFast\get_supported_algorithms() to see valid values
+
+Warning: fwrite(): Digest object not initialized. Call constructor first in %s on line %d
+bool(false)
+
+Warning: fwrite(): Digest algorithm no longer matches filter "crcfast.crc64nvme" in %s on line %d
+bool(false)
+int(9)
+string(16) "ae8b14860a799888"
+bool(false)
+bool(false)
+bool(false)
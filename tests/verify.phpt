@@ -0,0 +1,110 @@
+--TEST--
+verify() and verify_many() test
+--EXTENSIONS--
+crc_fast
+--SKIPIF--
+<?php if (PHP_INT_SIZE < 8) die('skip 64-bit only'); ?>
+--FILE--
+<?php
+// every encoding hash() and hash_int() can produce
+foreach ([
+    'e3069283',
+    'E3069283',
+    hex2bin('e3069283'),
+    '4waSgw==',
+    3808858755,
+] as $expected) {
+    var_dump(CrcFast\verify(CrcFast\CRC_32_ISCSI, '123456789', $expected));
+}
+
+foreach ([
+    'ae8b14860a799888',
+    hex2bin('ae8b14860a799888'),
+    'rosUhgp5mIg=',
+    -5869575123413395320,
+] as $expected) {
+    var_dump(CrcFast\verify(CrcFast\CRC_64_NVME, '123456789', $expected));
+}
+
+// CRC-32/PHP compares against its byte-reversed output
+var_dump(CrcFast\verify(CrcFast\CRC_32_PHP, '123456789', '181989fc'));
+var_dump(CrcFast\verify(CrcFast\CRC_32_PHP, '123456789', 'GBmJ/A=='));
+
+// custom parameters
+$params = new CrcFast\Params(64, 0xAD93D23594C93659, 0xFFFFFFFFFFFFFFFF, true, true, 0xFFFFFFFFFFFFFFFF, 0xAE8B14860A799888);
+var_dump(CrcFast\verify($params, '123456789', 'ae8b14860a799888'));
+
+// mismatches
+var_dump(CrcFast\verify(CrcFast\CRC_32_ISCSI, '12345678', 'e3069283'));
+var_dump(CrcFast\verify(CrcFast\CRC_32_ISCSI, '123456789', 'e3069284'));
+var_dump(CrcFast\verify(CrcFast\CRC_64_NVME, '123456789', 'rosUhgp5mIc='));
+
+// batches keep their keys
+var_dump(CrcFast\verify_many(CrcFast\CRC_32_ISCSI, [
+    'a' => ['123456789', 'e3069283'],
+    'b' => ['123456789', 3808858755],
+    'c' => ['12345678', '4waSgw=='],
+    7 => ['', '00000000'],
+]));
+var_dump(CrcFast\verify_many(CrcFast\CRC_32_ISCSI, []));
+
+// invalid expected checksums
+foreach (['e306928', 'zz069283', '4waSgw=A', 0x100000000, -1, 1.5] as $expected) {
+    try {
+        CrcFast\verify(CrcFast\CRC_32_ISCSI, '123456789', $expected);
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+}
+
+foreach ([
+    ['nope'],
+    [['123456789']],
+    [[123456789, 'e3069283']],
+    [['123456789', 'e30692']],
+] as $pairs) {
+    try {
+        CrcFast\verify_many(CrcFast\CRC_64_NVME, $pairs);
+    } catch (Exception $e) {
+        echo $e->getMessage(), "\n";
+    }
+}
+?>
+--EXPECT--
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+bool(false)
+bool(false)
+bool(false)
+array(4) {
+  ["a"]=>
+  bool(true)
+  ["b"]=>
+  bool(true)
+  ["c"]=>
+  bool(false)
+  [7]=>
+  bool(true)
+}
+array(0) {
+}
+Invalid expected checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Invalid expected checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Invalid expected checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Invalid expected checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Invalid expected checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Invalid expected checksum, expected an int, 4 binary bytes, 8 hex characters or 8 base64 characters
+Pair 0 must be an array of [string data, expected checksum]
+Pair 0 must be an array of [string data, expected checksum]
+Pair 0 must be an array of [string data, expected checksum]
+Pair 0 has an invalid expected checksum, expected an int, 8 binary bytes, 16 hex characters or 12 base64 characters